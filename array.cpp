@@ -0,0 +1,282 @@
+//
+// Created by gosktin on 19.10.26.
+//
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+
+#include "array.h"
+#include "execution.h"
+
+ReductionContext::ReductionContext(const BigInteger &modulus) :
+        modulus_(modulus.abs()), reciprocal_(reciprocal(modulus_)), length_(modulus_.size()) {}
+
+// Newton's iteration x' = 2x - m x^2 / 10^2k, started from the reciprocal of
+// the leading half of m, roughly doubles the correct digits and leaves an
+// error of a few units, which the last loops remove. Long moduli thus cost
+// a few multiplications instead of a long division.
+BigInteger ReductionContext::reciprocal(const BigInteger &modulus) {
+    const size_t smallest = 32;
+
+    size_t k = modulus.size();
+    if (k <= smallest)
+        return BigInteger(1).shiftLeft(2 * k) / modulus;
+
+    size_t h = (k + 1) / 2 + 2;
+    BigInteger x(reciprocal(modulus.shiftRight(k - h)).shiftLeft(k - h));
+    x = x * 2 - (modulus * x * x).shiftRight(2 * k);
+
+    BigInteger error(BigInteger(1).shiftLeft(2 * k) - modulus * x);
+    while (error.isNegative() && !executionCancelled()) {
+        --x;
+        error += modulus;
+    }
+    while (error >= modulus && !executionCancelled()) {
+        ++x;
+        error -= modulus;
+    }
+
+    return x;
+}
+
+// The estimate floor(floor(value / 10^(k-1)) * reciprocal / 10^(k+1)) falls
+// short of the quotient by at most two.
+BigInteger ReductionContext::reduceShort(const BigInteger &value, BigInteger *quotient) const {
+    BigInteger estimate((value.shiftRight(length_ - 1) * reciprocal_).shiftRight(length_ + 1));
+    BigInteger remainder(value - estimate * modulus_);
+    while (remainder >= modulus_ && !executionCancelled()) {
+        remainder -= modulus_;
+        ++estimate;
+    }
+    if (quotient)
+        *quotient = estimate;
+
+    return remainder;
+}
+
+// Folds the digits in from the top, k at a time, so every step reduces a
+// number below 10^2k and contributes the k quotient digits at its position.
+BigInteger ReductionContext::reduceDigits(const int *digits, size_t count, int *quotient) const {
+    if (count < length_)
+        return BigInteger(digits, count, true);
+
+    BigInteger part;
+    BigInteger *parts = quotient ? &part : 0;
+    size_t position = count - (count % length_ == 0 ? length_ : count % length_);
+    BigInteger remainder(reduceShort(BigInteger(digits + position, count - position, true), parts));
+    if (quotient)
+        std::copy(part.number_.begin(), part.number_.end(), quotient + position);
+    DigitVector window;
+    while (position > 0 && !executionCancelled()) {
+        position -= length_;
+        window.assign(digits + position, digits + position + length_);
+        window.insert(window.end(), remainder.number_.begin(), remainder.number_.end());
+        remainder = reduceShort(BigInteger(window.data(), window.size(), true), parts);
+        if (quotient)
+            std::copy(part.number_.begin(), part.number_.end(), quotient + position);
+    }
+
+    return remainder;
+}
+
+BigInteger ReductionContext::reduce(const BigInteger &value) const {
+    BigInteger remainder(reduceDigits(value.number_.data(), value.size()));
+    if (remainder && value.isNegative())
+        remainder.positive_ = false;
+
+    return remainder;
+}
+
+void ReductionContext::divmod(const BigInteger &value, BigInteger &quotient, BigInteger &remainder) const {
+    bool negative = value.isNegative();
+    DigitVector digits(value.size(), 0);
+    remainder = reduceDigits(value.number_.data(), value.size(), digits.data());
+    quotient = BigInteger(digits.data(), digits.size(), !negative);
+    if (remainder && negative)
+        remainder.positive_ = false;
+}
+
+BigIntegerArray::BigIntegerArray() : offsets_(1, 0) {}
+
+BigIntegerArray::BigIntegerArray(const std::vector<BigInteger> &values) : offsets_(1, 0) {
+    size_t digits = 0;
+    for (size_t i = 0; i < values.size(); ++i)
+        digits += values[i].size();
+    reserve(values.size(), digits);
+
+    for (size_t i = 0; i < values.size(); ++i)
+        push_back(values[i]);
+}
+
+void BigIntegerArray::push_back(const BigInteger &value) {
+    pool_.insert(pool_.end(), value.number_.begin(), value.number_.end());
+    offsets_.push_back(pool_.size());
+    negative_.push_back(value.isNegative());
+}
+
+void BigIntegerArray::reserve(size_t count, size_t digits) {
+    pool_.reserve(digits);
+    offsets_.reserve(count + 1);
+    negative_.reserve(count);
+}
+
+BigInteger BigIntegerArray::operator[](size_t i) const {
+    return BigInteger(data(i), length(i), !negative_[i]);
+}
+
+std::vector<BigInteger> BigIntegerArray::toVector() const {
+    std::vector<BigInteger> values;
+    values.reserve(size());
+    for (size_t i = 0; i < size(); ++i)
+        values.push_back(operator[](i));
+
+    return values;
+}
+
+// Digits are canonical: no leading zeros except in zero itself.
+static int compareDigits(const int *a, size_t n, const int *b, size_t m) {
+    if (n != m)
+        return n < m ? -1 : 1;
+    for (size_t i = n; i > 0; --i)
+        if (a[i - 1] != b[i - 1])
+            return a[i - 1] < b[i - 1] ? -1 : 1;
+
+    return 0;
+}
+
+size_t BigIntegerArray::addBound(const BigIntegerArray &a, const BigIntegerArray &b, const void *, size_t i) {
+    return max(a.length(i), b.length(i)) + 1;
+}
+
+size_t BigIntegerArray::multiplyBound(const BigIntegerArray &a, const BigIntegerArray &b, const void *, size_t i) {
+    return a.length(i) + b.length(i);
+}
+
+size_t BigIntegerArray::modBound(const BigIntegerArray &a, const BigIntegerArray &, const void *extra, size_t i) {
+    return std::min(a.length(i), static_cast<const ReductionContext *>(extra)->length_);
+}
+
+// `extra` points to a bool telling whether b is subtracted.
+size_t BigIntegerArray::addKernel(const BigIntegerArray &a, const BigIntegerArray &b, const void *extra, size_t i,
+                                  int *out, bool &negative) {
+    const int *x = a.data(i), *y = b.data(i);
+    size_t n = a.length(i), m = b.length(i);
+    bool xNegative = a.negative_[i] != 0, yNegative = (b.negative_[i] != 0) != *static_cast<const bool *>(extra);
+
+    if (xNegative == yNegative) {
+        if (n < m) {
+            std::swap(x, y);
+            std::swap(n, m);
+        }
+        std::copy(x, x + n, out);
+        out[n] = 0;
+        BigInteger::addDigits(out, n + 1, y, m);
+        negative = xNegative;
+
+        return n + 1;
+    }
+
+    negative = xNegative;
+    if (compareDigits(x, n, y, m) < 0) {
+        std::swap(x, y);
+        std::swap(n, m);
+        negative = yNegative;
+    }
+    std::copy(x, x + n, out);
+    BigInteger::subtractDigits(out, n, y, m);
+
+    return n;
+}
+
+size_t BigIntegerArray::multiplyKernel(const BigIntegerArray &a, const BigIntegerArray &b, const void *, size_t i,
+                                       int *out, bool &negative) {
+    BigInteger::multiplyDigits(a.data(i), a.length(i), b.data(i), b.length(i), out);
+    negative = a.negative_[i] != b.negative_[i];
+
+    return a.length(i) + b.length(i);
+}
+
+size_t BigIntegerArray::modKernel(const BigIntegerArray &a, const BigIntegerArray &, const void *extra, size_t i,
+                                  int *out, bool &negative) {
+    BigInteger remainder(static_cast<const ReductionContext *>(extra)->reduceDigits(a.data(i), a.length(i)));
+    std::copy(remainder.number_.begin(), remainder.number_.end(), out);
+    negative = a.negative_[i] != 0;
+
+    return remainder.size();
+}
+
+// The elements are split between the threads by the number of output digits
+// rather than by count, so a few long operands do not all land on one thread.
+BigIntegerArray BigIntegerArray::apply(const BigIntegerArray &a, const BigIntegerArray &b, const void *extra,
+                                       Bound bound, Kernel kernel, unsigned threads) {
+    size_t n = a.size();
+    std::vector<size_t> bounds(n + 1, 0);
+    for (size_t i = 0; i < n; ++i)
+        bounds[i + 1] = bounds[i] + bound(a, b, extra, i);
+
+    BigIntegerArray result;
+    result.pool_.resize(bounds[n]);
+    result.offsets_.assign(n + 1, 0);
+    result.negative_.assign(n, 0);
+    std::vector<size_t> used(n);
+
+    std::function<void(size_t, size_t)> run = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            int *out = result.pool_.data() + bounds[i];
+            bool negative = false;
+            size_t length = kernel(a, b, extra, i, out, negative);
+            while (length > 1 && out[length - 1] == 0)
+                --length;
+            used[i] = length;
+            result.negative_[i] = negative && (length > 1 || out[0] != 0);
+        }
+    };
+
+    if (threads == 0)
+        threads = max(std::thread::hardware_concurrency(), 1u);
+    size_t chunks = std::min(static_cast<size_t>(threads), n);
+    std::vector<size_t> splits(1, 0);
+    for (size_t k = 1; k < chunks; ++k)
+        splits.push_back(static_cast<size_t>(
+                std::lower_bound(bounds.begin(), bounds.end(), bounds[n] / chunks * k) - bounds.begin()));
+    splits.push_back(n);
+
+    std::vector<std::thread> workers;
+    for (size_t k = 1; k + 1 < splits.size(); ++k)
+        workers.push_back(std::thread(run, splits[k], splits[k + 1]));
+    run(splits[0], splits.size() > 1 ? splits[1] : n);
+    for (size_t k = 0; k < workers.size(); ++k)
+        workers[k].join();
+
+    // Every element moves down to close the gaps left by the bounds.
+    size_t end = 0;
+    for (size_t i = 0; i < n; ++i) {
+        std::copy(result.pool_.begin() + bounds[i], result.pool_.begin() + bounds[i] + used[i],
+                  result.pool_.begin() + end);
+        result.offsets_[i] = end;
+        end += used[i];
+    }
+    result.offsets_[n] = end;
+    result.pool_.resize(end);
+
+    return result;
+}
+
+BigIntegerArray BigIntegerArray::add(const BigIntegerArray &a, const BigIntegerArray &b, unsigned threads) {
+    static const bool subtract = false;
+    return apply(a, b, &subtract, addBound, addKernel, threads);
+}
+
+BigIntegerArray BigIntegerArray::subtract(const BigIntegerArray &a, const BigIntegerArray &b, unsigned threads) {
+    static const bool subtract = true;
+    return apply(a, b, &subtract, addBound, addKernel, threads);
+}
+
+BigIntegerArray BigIntegerArray::multiply(const BigIntegerArray &a, const BigIntegerArray &b, unsigned threads) {
+    return apply(a, b, 0, multiplyBound, multiplyKernel, threads);
+}
+
+BigIntegerArray BigIntegerArray::mod(const BigIntegerArray &a, const ReductionContext &context, unsigned threads) {
+    return apply(a, a, &context, modBound, modKernel, threads);
+}
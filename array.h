@@ -0,0 +1,109 @@
+//
+// Created by gosktin on 19.10.26.
+//
+
+#ifndef ARRAY_H
+#define ARRAY_H
+
+#include <cstddef>
+#include <vector>
+
+#include "biginteger.h"
+
+// Remainders by one fixed modulus through Barrett reduction. The reciprocal
+// floor(10^2k / |modulus|), k being the digit count of the modulus, is
+// computed once; every reduction after that costs two multiplications per k
+// digits of the dividend instead of a long division.
+class ReductionContext {
+public:
+    // `modulus` must not be zero.
+    explicit ReductionContext(const BigInteger &modulus);
+
+    const BigInteger &modulus() const { return modulus_; }
+
+    // Same result as value % modulus, so the sign follows `value`.
+    BigInteger reduce(const BigInteger &value) const;
+    // Truncated division by |modulus|: both results take the sign of
+    // `value`. The quotient comes k digits per reduction step, so long
+    // quotients cost multiplications instead of a long division.
+    void divmod(const BigInteger &value, BigInteger &quotient, BigInteger &remainder) const;
+
+private:
+    friend class BigIntegerArray;
+
+    BigInteger modulus_;
+    BigInteger reciprocal_;
+    size_t length_;
+
+    // floor(10^2k / modulus) for a positive modulus of k digits.
+    static BigInteger reciprocal(const BigInteger &modulus);
+
+    // |digits| mod |modulus|; the quotient digits go to `quotient` unless
+    // it is null, which then has room for `count` digits.
+    BigInteger reduceDigits(const int *digits, size_t count, int *quotient = 0) const;
+    // Requires 0 <= value < 10^2k.
+    BigInteger reduceShort(const BigInteger &value, BigInteger *quotient = 0) const;
+};
+
+// Many independent integers kept back to back in one digit pool, with an
+// offset and a sign per element. The element-wise operations size their
+// output from the operands up front, fill disjoint ranges of a single pool
+// from several threads and compact it afterwards, so a batch allocates a
+// handful of times instead of once per element.
+class BigIntegerArray {
+public:
+    BigIntegerArray();
+    explicit BigIntegerArray(const std::vector<BigInteger> &values);
+
+    void push_back(const BigInteger &value);
+    void reserve(size_t count, size_t digits);
+
+    size_t size() const { return negative_.size(); }
+    // Total number of digits in the pool.
+    size_t digits() const { return pool_.size(); }
+
+    BigInteger operator[](size_t i) const;
+    std::vector<BigInteger> toVector() const;
+
+    // Element-wise operations on arrays of equal size. `threads` is the
+    // number of threads to split the elements between, 0 meaning one per
+    // hardware thread.
+    static BigIntegerArray add(const BigIntegerArray &a, const BigIntegerArray &b, unsigned threads = 1);
+    static BigIntegerArray subtract(const BigIntegerArray &a, const BigIntegerArray &b, unsigned threads = 1);
+    static BigIntegerArray multiply(const BigIntegerArray &a, const BigIntegerArray &b, unsigned threads = 1);
+    // a[i] % modulus for every element.
+    static BigIntegerArray mod(const BigIntegerArray &a, const ReductionContext &context, unsigned threads = 1);
+
+private:
+    template <typename URBG> friend class RandomDigits;
+
+    DigitVector pool_;
+    std::vector<size_t> offsets_;
+    std::vector<char> negative_;
+
+    const int *data(size_t i) const { return pool_.data() + offsets_[i]; }
+    size_t length(size_t i) const { return offsets_[i + 1] - offsets_[i]; }
+
+    // Writes the digits of element `i` of the result into `out`, which has
+    // room for as many digits as the bound promised, and returns how many
+    // were used; the sign goes to `negative`.
+    typedef size_t (*Bound)(const BigIntegerArray &a, const BigIntegerArray &b, const void *extra, size_t i);
+    typedef size_t (*Kernel)(const BigIntegerArray &a, const BigIntegerArray &b, const void *extra, size_t i,
+                             int *out, bool &negative);
+
+    static BigIntegerArray apply(const BigIntegerArray &a, const BigIntegerArray &b, const void *extra,
+                                 Bound bound, Kernel kernel, unsigned threads);
+
+    static size_t addBound(const BigIntegerArray &a, const BigIntegerArray &b, const void *, size_t i);
+    static size_t multiplyBound(const BigIntegerArray &a, const BigIntegerArray &b, const void *, size_t i);
+    static size_t modBound(const BigIntegerArray &a, const BigIntegerArray &, const void *extra, size_t i);
+
+    static size_t addKernel(const BigIntegerArray &a, const BigIntegerArray &b, const void *extra, size_t i,
+                            int *out, bool &negative);
+    static size_t multiplyKernel(const BigIntegerArray &a, const BigIntegerArray &b, const void *, size_t i,
+                                 int *out, bool &negative);
+    static size_t modKernel(const BigIntegerArray &a, const BigIntegerArray &, const void *extra, size_t i,
+                            int *out, bool &negative);
+};
+
+#endif //ARRAY_H
@@ -0,0 +1,26 @@
+//
+// Created by gosktin on 19.10.26.
+//
+
+#include "async.h"
+
+AsyncResult<BigInteger> multiplyAsync(const BigInteger &left, const BigInteger &right,
+                                      const CancellationToken &token, const ProgressCallback &progress) {
+    return runAsync<BigInteger>([left, right]() { return left * right; }, token, progress);
+}
+
+AsyncResult<std::pair<BigInteger, BigInteger> > divmodAsync(const BigInteger &left, const BigInteger &right,
+                                                            const CancellationToken &token,
+                                                            const ProgressCallback &progress) {
+    return runAsync<std::pair<BigInteger, BigInteger> >([left, right]() {
+        std::pair<BigInteger, BigInteger> result;
+        BigInteger::divmod(left, right, result.first, result.second);
+        return result;
+    }, token, progress);
+}
+
+AsyncResult<std::string> asDecimalAsync(const Rational &value, size_t precision, bool rounded,
+                                        const CancellationToken &token, const ProgressCallback &progress) {
+    return runAsync<std::string>([value, precision, rounded]() { return value.asDecimal(precision, rounded); },
+                                 token, progress);
+}
@@ -0,0 +1,128 @@
+//
+// Created by gosktin on 19.10.26.
+//
+
+#ifndef ASYNC_H
+#define ASYNC_H
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "execution.h"
+#include "parallel.h"
+
+// The result of an operation running on the pool. get() keeps running
+// pending pool tasks while it waits, so it is safe to call from a worker.
+template <typename T>
+class AsyncResult {
+public:
+    AsyncResult(const CancellationToken &token, ThreadPool &pool) : state_(std::make_shared<State>(token)),
+                                                                   pool_(&pool) {}
+
+    void cancel() { state_->token.cancel(); }
+
+    // True once the operation has finished or given up.
+    bool ready() const {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        return state_->done;
+    }
+
+    // False if `timeout` passed first.
+    bool waitFor(std::chrono::steady_clock::duration timeout) const {
+        std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + timeout;
+        return waitUntil(&deadline);
+    }
+
+    // Waits for the operation; false if it was cancelled, `value` being left
+    // alone then.
+    bool get(T &value) const {
+        waitUntil(0);
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        if (state_->cancelled)
+            return false;
+        value = state_->value;
+
+        return true;
+    }
+
+    // Runs `work` under the token; a result computed while the token was set
+    // at any point is not trusted and counts as cancelled.
+    void start(const std::function<T()> &work, const ProgressCallback &progress) {
+        std::shared_ptr<State> state(state_);
+        pool_->submit([state, work, progress]() {
+            T value;
+            if (!state->token.cancelled()) {
+                ExecutionScope scope(state->token, progress);
+                value = work();
+            }
+            bool cancelled = state->token.cancelled();
+
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (!cancelled)
+                state->value = value;
+            state->cancelled = cancelled;
+            state->done = true;
+            state->finished.notify_all();
+        });
+    }
+
+private:
+    struct State {
+        explicit State(const CancellationToken &token) : token(token), done(false), cancelled(false) {}
+
+        CancellationToken token;
+        std::mutex mutex;
+        std::condition_variable finished;
+        bool done;
+        bool cancelled;
+        T value;
+    };
+
+    std::shared_ptr<State> state_;
+    ThreadPool *pool_;
+
+    // Only an unbounded wait helps with pending tasks, since one of them may
+    // run well past the deadline.
+    bool waitUntil(const std::chrono::steady_clock::time_point *deadline) const {
+        while (!ready()) {
+            if (deadline && std::chrono::steady_clock::now() >= *deadline)
+                return false;
+            if (!deadline && pool_->runPending())
+                continue;
+            std::unique_lock<std::mutex> lock(state_->mutex);
+            state_->finished.wait_for(lock, std::chrono::milliseconds(1), [this]() { return state_->done; });
+        }
+
+        return true;
+    }
+};
+
+template <typename T>
+AsyncResult<T> runAsync(const std::function<T()> &work, const CancellationToken &token = CancellationToken(),
+                        const ProgressCallback &progress = ProgressCallback(),
+                        ThreadPool &pool = ThreadPool::shared()) {
+    AsyncResult<T> result(token, pool);
+    result.start(work, progress);
+
+    return result;
+}
+
+// The long operations, with copies of their operands. Progress is counted in
+// quotient digits for the division and in digits written for asDecimal; the
+// multiplication can only be cancelled.
+AsyncResult<BigInteger> multiplyAsync(const BigInteger &left, const BigInteger &right,
+                                      const CancellationToken &token = CancellationToken(),
+                                      const ProgressCallback &progress = ProgressCallback());
+AsyncResult<std::pair<BigInteger, BigInteger> > divmodAsync(const BigInteger &left, const BigInteger &right,
+                                                            const CancellationToken &token = CancellationToken(),
+                                                            const ProgressCallback &progress = ProgressCallback());
+AsyncResult<std::string> asDecimalAsync(const Rational &value, size_t precision, bool rounded = false,
+                                        const CancellationToken &token = CancellationToken(),
+                                        const ProgressCallback &progress = ProgressCallback());
+
+#endif //ASYNC_H
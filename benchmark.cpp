@@ -0,0 +1,192 @@
+//
+// Created by gosktin on 19.10.26.
+//
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "rational.h"
+
+// Every case is run at 1, 10, 100, ... digits up to --max-digits. An
+// operation stops growing once a single call takes longer than --max-time
+// seconds, so the quadratic ones do not hold up the sweep. Results are
+// written as JSON in the layout Google Benchmark uses.
+
+struct Operands {
+    BigInteger a;
+    BigInteger b;
+    Rational x;
+    Rational y;
+    std::string text;
+};
+
+struct Case {
+    std::string name;
+    std::function<size_t(Operands &)> run;
+};
+
+// Results are stored here so that the calls cannot be optimized away.
+volatile size_t observed;
+
+struct Result {
+    std::string name;
+    size_t digits;
+    size_t iterations;
+    double nanoseconds;
+};
+
+std::string randomDigits(std::mt19937_64 &rng, size_t digits) {
+    std::string s(digits, '0');
+    for (size_t i = 0; i < digits; ++i)
+        s[i] = static_cast<char>('0' + rng() % 10);
+    if (s[0] == '0')
+        s[0] = '1';
+
+    return s;
+}
+
+Operands makeOperands(std::mt19937_64 &rng, size_t digits) {
+    Operands o;
+    o.text = randomDigits(rng, digits);
+    o.a = BigInteger(o.text);
+    o.b = BigInteger(randomDigits(rng, max(digits / 2, static_cast<size_t>(1))));
+
+    return o;
+}
+
+// Reducing the fractions costs a gcd, so this is only done while some
+// Rational case is still running.
+void makeRationals(std::mt19937_64 &rng, Operands &o) {
+    size_t digits = o.text.size();
+    o.x = Rational(o.a, BigInteger(randomDigits(rng, digits)));
+    o.y = Rational(BigInteger(randomDigits(rng, digits)), o.b);
+}
+
+std::vector<Case> cases() {
+    std::vector<Case> all;
+    all.push_back({"BigInteger/add", [](Operands &o) { return (o.a + o.b).size(); }});
+    all.push_back({"BigInteger/sub", [](Operands &o) { return (o.a - o.b).size(); }});
+    all.push_back({"BigInteger/mul", [](Operands &o) { return (o.a * o.b).size(); }});
+    all.push_back({"BigInteger/div", [](Operands &o) { return (o.a / o.b).size(); }});
+    all.push_back({"BigInteger/mod", [](Operands &o) { return (o.a % o.b).size(); }});
+    all.push_back({"BigInteger/gcd", [](Operands &o) { return gcd(o.a, o.b).size(); }});
+    all.push_back({"BigInteger/less", [](Operands &o) { return o.a < o.b; }});
+    all.push_back({"BigInteger/toString", [](Operands &o) { return o.a.toString().size(); }});
+    all.push_back({"BigInteger/parse", [](Operands &o) { return BigInteger(o.text).size(); }});
+    all.push_back({"Rational/add", [](Operands &o) { return (o.x + o.y).p().first.size(); }});
+    all.push_back({"Rational/sub", [](Operands &o) { return (o.x - o.y).p().first.size(); }});
+    all.push_back({"Rational/mul", [](Operands &o) { return (o.x * o.y).p().first.size(); }});
+    all.push_back({"Rational/div", [](Operands &o) { return (o.x / o.y).p().first.size(); }});
+    all.push_back({"Rational/less", [](Operands &o) { return o.x < o.y; }});
+    all.push_back({"Rational/equal", [](Operands &o) { return o.x == o.y; }});
+    all.push_back({"Rational/toDouble", [](Operands &o) { return static_cast<double>(o.x) != 0; }});
+    all.push_back({"Rational/asDecimal", [](Operands &o) { return o.x.asDecimal(o.text.size()).size(); }});
+    all.push_back({"Rational/toString", [](Operands &o) { return o.x.toString().size(); }});
+
+    return all;
+}
+
+bool isRational(const Case &c) {
+    return c.name.compare(0, 9, "Rational/") == 0;
+}
+
+// Repeats the call until `minTime` seconds have passed and reports the mean.
+Result measure(const Case &c, Operands &operands, size_t digits, double minTime) {
+    typedef std::chrono::steady_clock Clock;
+
+    Result result = {c.name, digits, 0, 0};
+    Clock::time_point start = Clock::now();
+    double elapsed = 0;
+    while (result.iterations == 0 || elapsed < minTime) {
+        observed = c.run(operands);
+        ++result.iterations;
+        elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    }
+    result.nanoseconds = elapsed * 1e9 / result.iterations;
+
+    return result;
+}
+
+std::string toJson(const std::vector<Result> &results, size_t maxDigits) {
+    std::ostringstream out;
+    out << "{\n  \"context\": {\"library\": \"numerical\", \"max_digits\": " << maxDigits << "},\n";
+    out << "  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        out << (i ? ",\n" : "\n");
+        out << "    {\"name\": \"" << results[i].name << '/' << results[i].digits << "\", "
+            << "\"digits\": " << results[i].digits << ", "
+            << "\"iterations\": " << results[i].iterations << ", "
+            << "\"real_time\": " << results[i].nanoseconds << ", "
+            << "\"time_unit\": \"ns\"}";
+    }
+    out << "\n  ]\n}\n";
+
+    return out.str();
+}
+
+int main(int argc, char **argv) {
+    size_t maxDigits = 1000000;
+    double minTime = 0.1, maxTime = 2;
+    std::string filter, output;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string flag(argv[i]);
+        if (flag == "--max-digits")
+            maxDigits = std::strtoull(argv[i + 1], 0, 10);
+        else if (flag == "--min-time")
+            minTime = std::atof(argv[i + 1]);
+        else if (flag == "--max-time")
+            maxTime = std::atof(argv[i + 1]);
+        else if (flag == "--filter")
+            filter = argv[i + 1];
+        else if (flag == "--out")
+            output = argv[i + 1];
+        else {
+            std::cerr << "usage: " << argv[0] << " [--max-digits N] [--min-time S] [--max-time S]"
+                      << " [--filter SUBSTRING] [--out FILE]" << std::endl;
+            return 1;
+        }
+    }
+
+    std::mt19937_64 rng(20161031);
+    std::vector<Case> all(cases());
+    std::vector<bool> stopped(all.size(), false);
+    for (size_t i = 0; i < all.size(); ++i)
+        stopped[i] = all[i].name.find(filter) == std::string::npos;
+    std::vector<Result> results;
+    for (size_t digits = 1; digits <= maxDigits; digits *= 10) {
+        Operands operands(makeOperands(rng, digits));
+        bool rationals = false;
+        for (size_t i = 0; i < all.size(); ++i)
+            rationals = rationals || (!stopped[i] && isRational(all[i]));
+        if (rationals) {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            makeRationals(rng, operands);
+            double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            for (size_t i = 0; i < all.size(); ++i)
+                stopped[i] = stopped[i] || (isRational(all[i]) && elapsed > maxTime);
+        }
+
+        for (size_t i = 0; i < all.size(); ++i) {
+            if (stopped[i])
+                continue;
+            Result result(measure(all[i], operands, digits, minTime));
+            results.push_back(result);
+            std::cerr << result.name << '/' << digits << ": " << result.nanoseconds << " ns" << std::endl;
+            stopped[i] = result.nanoseconds > maxTime * 1e9;
+        }
+    }
+
+    if (output.empty())
+        std::cout << toJson(results, maxDigits);
+    else
+        std::ofstream(output.c_str()) << toJson(results, maxDigits);
+
+    return 0;
+}
@@ -0,0 +1,303 @@
+//
+// Created by gosktin on 19.10.26.
+//
+
+#include <cstdlib>
+
+#include "array.h"
+#include "bigfloat.h"
+#include "series.h"
+
+BigFloat::BigFloat() : mantissa_(0), exponent_(0), precision_(defaultPrecision) {}
+
+BigFloat::BigFloat(int value, size_t precision) {
+    *this = BigFloat(BigInteger(value), 0, false, precision, RoundNearestEven);
+}
+
+BigFloat::BigFloat(const BigInteger &value, size_t precision, RoundingMode mode) {
+    *this = BigFloat(value, 0, false, precision, mode);
+}
+
+BigFloat::BigFloat(const Rational &value, size_t precision, RoundingMode mode) {
+    const BigInteger &numerator(value.numerator()), &denominator(value.denominator());
+    if (!numerator)
+        *this = BigFloat(BigInteger(0), 0, false, precision, mode);
+    else
+        *this = quotient(numerator.abs(), 0, denominator.abs(), 0, numerator.isNegative() != denominator.isNegative(),
+                         precision, mode);
+}
+
+BigFloat::BigFloat(const std::string &text, size_t precision, RoundingMode mode) {
+    size_t i = 0;
+    bool negative = false;
+    if (i < text.size() && (text[i] == '-' || text[i] == '+'))
+        negative = text[i++] == '-';
+
+    std::string digits;
+    long long exponent = 0;
+    bool point = false;
+    for (; i < text.size() && text[i] != 'e' && text[i] != 'E'; ++i) {
+        if (text[i] == '.') {
+            point = true;
+            continue;
+        }
+        digits += text[i];
+        if (point)
+            --exponent;
+    }
+    if (i < text.size())
+        exponent += std::strtoll(text.c_str() + i + 1, 0, 10);
+
+    size_t first = digits.find_first_not_of('0');
+    BigInteger mantissa(first == std::string::npos ? "0" : digits.substr(first));
+    *this = BigFloat(negative ? -mantissa : mantissa, exponent, false, precision, mode);
+}
+
+// Keeps the leading `precision` digits and decides from the first dropped
+// digit and whether anything below it is nonzero, the inexact tail included,
+// in which direction the mode moves the kept part.
+BigFloat::BigFloat(const BigInteger &mantissa, long long exponent, bool inexact, size_t precision,
+                   RoundingMode mode) : exponent_(exponent), precision_(max<size_t>(precision, 1)) {
+    bool negative = mantissa.isNegative();
+    BigInteger magnitude(mantissa.abs());
+    if (inexact && magnitude.size() <= precision_) {
+        exponent_ -= precision_ + 1 - magnitude.size();
+        magnitude = magnitude.shiftLeft(precision_ + 1 - magnitude.size());
+    }
+
+    if (magnitude.size() > precision_) {
+        size_t drop = magnitude.size() - precision_;
+        const DigitVector &digits = magnitude.number_;
+        int first = digits[drop - 1];
+        bool rest = inexact;
+        for (size_t i = 0; i + 1 < drop && !rest; ++i)
+            rest = digits[i] != 0;
+
+        BigInteger kept(digits.data() + drop, precision_, true);
+        exponent_ += drop;
+        bool up;
+        switch (mode) {
+            case RoundNearestEven:
+                up = first > 5 || (first == 5 && (rest || kept.number_[0] % 2 == 1));
+                break;
+            case RoundTowardZero:
+                up = false;
+                break;
+            case RoundUpward:
+                up = (first || rest) && !negative;
+                break;
+            case RoundDownward:
+                up = (first || rest) && negative;
+                break;
+            default:
+                up = first || rest;
+        }
+        if (up)
+            ++kept;
+        magnitude = kept;
+    }
+
+    size_t zeros = 0;
+    while (zeros + 1 < magnitude.size() && magnitude.number_[zeros] == 0)
+        ++zeros;
+    if (zeros > 0) {
+        magnitude = BigInteger(magnitude.number_.data() + zeros, magnitude.size() - zeros, true);
+        exponent_ += zeros;
+    }
+    if (!magnitude)
+        exponent_ = 0;
+
+    mantissa_ = negative ? -magnitude : magnitude;
+}
+
+// Aligning the operands exactly would take as many digits as their exponents
+// are apart. When the smaller one lies wholly below the last digit of the
+// larger one held to precision + 2 digits, only its sign can matter: the
+// larger one plus or minus a unit one place further down rounds the same.
+BigFloat BigFloat::add(const BigFloat &left, const BigFloat &right, size_t precision, RoundingMode mode) {
+    if (!right)
+        return BigFloat(left.mantissa_, left.exponent_, false, precision, mode);
+    if (!left)
+        return BigFloat(right.mantissa_, right.exponent_, false, precision, mode);
+
+    const BigFloat &big = left.exponent_ + static_cast<long long>(left.mantissa_.size()) >=
+                          right.exponent_ + static_cast<long long>(right.mantissa_.size()) ? left : right;
+    const BigFloat &small = &big == &left ? right : left;
+
+    size_t extend = precision + 2 > big.mantissa_.size() ? precision + 2 - big.mantissa_.size() : 0;
+    long long floor = big.exponent_ - static_cast<long long>(extend);
+    if (small.exponent_ + static_cast<long long>(small.mantissa_.size()) <= floor) {
+        BigInteger unit(small.isNegative() ? -1 : 1);
+        return BigFloat(big.mantissa_.shiftLeft(extend + 1) + unit, floor - 1, false, precision, mode);
+    }
+
+    long long exponent = std::min(big.exponent_, small.exponent_);
+    return BigFloat(big.mantissa_.shiftLeft(static_cast<size_t>(big.exponent_ - exponent)) +
+                    small.mantissa_.shiftLeft(static_cast<size_t>(small.exponent_ - exponent)),
+                    exponent, false, precision, mode);
+}
+
+BigFloat BigFloat::subtract(const BigFloat &left, const BigFloat &right, size_t precision, RoundingMode mode) {
+    return add(left, -right, precision, mode);
+}
+
+BigFloat BigFloat::multiply(const BigFloat &left, const BigFloat &right, size_t precision, RoundingMode mode) {
+    return BigFloat(left.mantissa_ * right.mantissa_, left.exponent_ + right.exponent_, false, precision, mode);
+}
+
+// The quotient is carried to precision + 2 digits; a nonzero remainder then
+// only marks it inexact.
+BigFloat BigFloat::quotient(const BigInteger &a, long long ea, const BigInteger &b, long long eb, bool negative,
+                            size_t precision, RoundingMode mode) {
+    size_t shift = precision + 2 + b.size() > a.size() ? precision + 2 + b.size() - a.size() : 0;
+    BigInteger q, r;
+    ReductionContext(b).divmod(a.shiftLeft(shift), q, r);
+
+    return BigFloat(negative ? -q : q, ea - eb - static_cast<long long>(shift), static_cast<bool>(r), precision,
+                    mode);
+}
+
+BigFloat BigFloat::divide(const BigFloat &left, const BigFloat &right, size_t precision, RoundingMode mode) {
+    if (!left)
+        return BigFloat(BigInteger(0), 0, false, precision, mode);
+
+    return quotient(left.mantissa_.abs(), left.exponent_, right.mantissa_.abs(), right.exponent_,
+                    left.isNegative() != right.isNegative(), precision, mode);
+}
+
+// The mantissa is scaled to at least 2 precision + 2 digits with an even
+// exponent, so that its integer root has precision + 1 of them.
+BigFloat BigFloat::squareRoot(const BigFloat &value, size_t precision, RoundingMode mode) {
+    if (!value)
+        return BigFloat(BigInteger(0), 0, false, precision, mode);
+
+    size_t shift = 2 * precision + 2 > value.mantissa_.size() ? 2 * precision + 2 - value.mantissa_.size() : 0;
+    if ((value.exponent_ - static_cast<long long>(shift)) % 2 != 0)
+        ++shift;
+    BigInteger scaled(value.mantissa_.shiftLeft(shift)), root(::squareRoot(scaled));
+
+    return BigFloat(root, (value.exponent_ - static_cast<long long>(shift)) / 2, root * root != scaled, precision,
+                    mode);
+}
+
+BigFloat BigFloat::squareRoot() const {
+    return squareRoot(*this, precision_, RoundNearestEven);
+}
+
+BigFloat BigFloat::operator-() const {
+    BigFloat result(*this);
+    result.mantissa_ = -mantissa_;
+
+    return result;
+}
+
+BigFloat &BigFloat::operator+=(const BigFloat &right) {
+    return *this = add(*this, right, max(precision_, right.precision_), RoundNearestEven);
+}
+
+BigFloat &BigFloat::operator-=(const BigFloat &right) {
+    return *this = subtract(*this, right, max(precision_, right.precision_), RoundNearestEven);
+}
+
+BigFloat &BigFloat::operator*=(const BigFloat &right) {
+    return *this = multiply(*this, right, max(precision_, right.precision_), RoundNearestEven);
+}
+
+BigFloat &BigFloat::operator/=(const BigFloat &right) {
+    return *this = divide(*this, right, max(precision_, right.precision_), RoundNearestEven);
+}
+
+// Mantissas have no leading zeros, so the position of the leading digit
+// decides unless it is the same for both.
+int BigFloat::compare(const BigFloat &left, const BigFloat &right) {
+    if (left.isNegative() != right.isNegative())
+        return left.isNegative() ? -1 : 1;
+    if (!left)
+        return !right ? 0 : -1;
+    if (!right)
+        return 1;
+
+    int sign = left.isNegative() ? -1 : 1;
+    long long leftTop = left.exponent_ + static_cast<long long>(left.mantissa_.size()),
+            rightTop = right.exponent_ + static_cast<long long>(right.mantissa_.size());
+    if (leftTop != rightTop)
+        return leftTop < rightTop ? -sign : sign;
+
+    long long exponent = std::min(left.exponent_, right.exponent_);
+    BigInteger a(left.mantissa_.abs().shiftLeft(static_cast<size_t>(left.exponent_ - exponent))),
+            b(right.mantissa_.abs().shiftLeft(static_cast<size_t>(right.exponent_ - exponent)));
+
+    return a == b ? 0 : (a < b ? -sign : sign);
+}
+
+bool BigFloat::operator==(const BigFloat &right) const {
+    return mantissa_ == right.mantissa_ && exponent_ == right.exponent_;
+}
+
+bool BigFloat::operator!=(const BigFloat &right) const {
+    return !(*this == right);
+}
+
+bool BigFloat::operator<(const BigFloat &right) const {
+    return compare(*this, right) < 0;
+}
+
+bool BigFloat::operator>(const BigFloat &right) const {
+    return compare(*this, right) > 0;
+}
+
+bool BigFloat::operator<=(const BigFloat &right) const {
+    return compare(*this, right) <= 0;
+}
+
+bool BigFloat::operator>=(const BigFloat &right) const {
+    return compare(*this, right) >= 0;
+}
+
+BigFloat BigFloat::withPrecision(size_t precision, RoundingMode mode) const {
+    return BigFloat(mantissa_, exponent_, false, precision, mode);
+}
+
+Rational BigFloat::toRational() const {
+    if (exponent_ >= 0)
+        return Rational(mantissa_.shiftLeft(static_cast<size_t>(exponent_)));
+
+    return Rational(mantissa_, BigInteger(1).shiftLeft(static_cast<size_t>(-exponent_)));
+}
+
+std::string BigFloat::toString() const {
+    std::string digits(mantissa_.abs().toString()), sign(isNegative() ? "-" : "");
+    long long size = static_cast<long long>(digits.size()), leading = exponent_ + size - 1;
+
+    if (leading < -6 || leading > 20) {
+        std::string fraction(size > 1 ? "." + digits.substr(1) : "");
+        return sign + digits[0] + fraction + (leading < 0 ? "e-" : "e+") + std::to_string(absolute(leading));
+    }
+    if (exponent_ >= 0)
+        return sign + digits + std::string(static_cast<size_t>(exponent_), '0');
+    if (leading >= 0)
+        return sign + digits.substr(0, static_cast<size_t>(leading + 1)) + "." +
+               digits.substr(static_cast<size_t>(leading + 1));
+
+    return sign + "0." + std::string(static_cast<size_t>(-leading - 1), '0') + digits;
+}
+
+BigFloat operator+(const BigFloat &left, const BigFloat &right) {
+    return BigFloat::add(left, right, max(left.precision(), right.precision()), RoundNearestEven);
+}
+
+BigFloat operator-(const BigFloat &left, const BigFloat &right) {
+    return BigFloat::subtract(left, right, max(left.precision(), right.precision()), RoundNearestEven);
+}
+
+BigFloat operator*(const BigFloat &left, const BigFloat &right) {
+    return BigFloat::multiply(left, right, max(left.precision(), right.precision()), RoundNearestEven);
+}
+
+BigFloat operator/(const BigFloat &left, const BigFloat &right) {
+    return BigFloat::divide(left, right, max(left.precision(), right.precision()), RoundNearestEven);
+}
+
+std::ostream &operator<<(std::ostream &out, const BigFloat &object) {
+    return out << object.toString();
+}
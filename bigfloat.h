@@ -0,0 +1,102 @@
+//
+// Created by gosktin on 19.10.26.
+//
+
+#ifndef BIGFLOAT_H
+#define BIGFLOAT_H
+
+#include <cstddef>
+#include <string>
+
+#include "biginteger.h"
+#include "rational.h"
+
+enum RoundingMode {
+    RoundNearestEven,
+    RoundTowardZero,
+    RoundUpward,
+    RoundDownward,
+    RoundAwayFromZero
+};
+
+// mantissa * 10^exponent with at most `precision` significant digits. The
+// exponent is decimal because the mantissa is: rounding and printing are
+// then digit slicing instead of base conversions. Every result is rounded
+// once from the exact value, as IEEE 754 does, so iterations keep operands
+// of fixed size. Trailing zeros are dropped from the mantissa, which makes
+// equal values equal digit for digit.
+class BigFloat {
+public:
+    static const size_t defaultPrecision = 50;
+
+    BigFloat();
+    BigFloat(int value, size_t precision = defaultPrecision);
+    BigFloat(const BigInteger &value, size_t precision = defaultPrecision, RoundingMode mode = RoundNearestEven);
+    BigFloat(const Rational &value, size_t precision = defaultPrecision, RoundingMode mode = RoundNearestEven);
+    // Parses "-12.5e-3" style text, rounding it to `precision` digits.
+    BigFloat(const std::string &text, size_t precision = defaultPrecision, RoundingMode mode = RoundNearestEven);
+
+    // The operators round to nearest, ties to even, at the larger of the two
+    // precisions; the static forms take both explicitly.
+    static BigFloat add(const BigFloat &left, const BigFloat &right, size_t precision, RoundingMode mode);
+    static BigFloat subtract(const BigFloat &left, const BigFloat &right, size_t precision, RoundingMode mode);
+    static BigFloat multiply(const BigFloat &left, const BigFloat &right, size_t precision, RoundingMode mode);
+    // `right` must not be zero.
+    static BigFloat divide(const BigFloat &left, const BigFloat &right, size_t precision, RoundingMode mode);
+    // For value >= 0, correctly rounded from the integer root of the mantissa
+    // scaled to twice the precision.
+    static BigFloat squareRoot(const BigFloat &value, size_t precision, RoundingMode mode);
+    BigFloat squareRoot() const;
+
+    BigFloat operator-() const;
+    BigFloat &operator+=(const BigFloat &right);
+    BigFloat &operator-=(const BigFloat &right);
+    BigFloat &operator*=(const BigFloat &right);
+    BigFloat &operator/=(const BigFloat &right);
+
+    bool operator==(const BigFloat &right) const;
+    bool operator!=(const BigFloat &right) const;
+    bool operator<(const BigFloat &right) const;
+    bool operator>(const BigFloat &right) const;
+    bool operator<=(const BigFloat &right) const;
+    bool operator>=(const BigFloat &right) const;
+
+    bool isNegative() const { return mantissa_.isNegative(); }
+    explicit operator bool() const { return static_cast<bool>(mantissa_); }
+
+    const BigInteger &mantissa() const { return mantissa_; }
+    long long exponent() const { return exponent_; }
+    size_t precision() const { return precision_; }
+    // The same value held to a new precision.
+    BigFloat withPrecision(size_t precision, RoundingMode mode = RoundNearestEven) const;
+
+    // The exact value.
+    Rational toRational() const;
+    // Positional notation while the decimal exponent of the leading digit is
+    // between -6 and 20, scientific ("1.25e+30") outside, as JavaScript does.
+    std::string toString() const;
+
+private:
+    BigInteger mantissa_;
+    long long exponent_;
+    size_t precision_;
+
+    // mantissa * 10^exponent rounded to `precision` digits. `inexact` says
+    // the exact magnitude lies above |mantissa| by less than one unit in its
+    // last digit, as the truncated quotients and roots do.
+    BigFloat(const BigInteger &mantissa, long long exponent, bool inexact, size_t precision, RoundingMode mode);
+
+    // (a 10^ea) / (b 10^eb) for a, b > 0, with the sign of the result given.
+    static BigFloat quotient(const BigInteger &a, long long ea, const BigInteger &b, long long eb, bool negative,
+                             size_t precision, RoundingMode mode);
+    static int compare(const BigFloat &left, const BigFloat &right);
+};
+
+BigFloat operator+(const BigFloat &left, const BigFloat &right);
+BigFloat operator-(const BigFloat &left, const BigFloat &right);
+BigFloat operator*(const BigFloat &left, const BigFloat &right);
+BigFloat operator/(const BigFloat &left, const BigFloat &right);
+
+std::ostream &operator<<(std::ostream &out, const BigFloat &object);
+
+#endif //BIGFLOAT_H
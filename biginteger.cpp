@@ -0,0 +1,869 @@
+//
+// Created by gosktin on 19.10.26.
+//
+
+#include <deque>
+#include <type_traits>
+#include <utility>
+
+#include "biginteger.h"
+#include "execution.h"
+
+void BigInteger::fill(size_t n) {
+    std::reverse(number_.begin(), number_.end());
+    size_t i = 0;
+    while (i < n) {
+        number_.push_back(0);
+        ++i;
+    }
+    std::reverse(number_.begin(), number_.end());
+}
+
+BigInteger::BigInteger() : positive_(true) {
+    number_.push_back(0);
+}
+
+BigInteger::BigInteger(int n) : positive_(n >= 0) {
+    if (n == 0)
+        number_.push_back(0);
+    n = absolute(n);
+    for (int i = n; i > 0; i /= 10)
+        number_.push_back(i % 10);
+}
+
+BigInteger::BigInteger(const int *digits, size_t count, bool positive) :
+        positive_(positive), number_(digits, digits + count) {
+    canonify();
+}
+
+BigInteger::BigInteger(const BigInteger &object) {
+    copy(object);
+}
+
+// Containers of numbers move them instead of copying only when this cannot
+// throw.
+BigInteger::BigInteger(BigInteger &&object) noexcept : positive_(object.positive_),
+                                                       number_(std::move(object.number_)) {}
+
+static_assert(std::is_nothrow_move_constructible<BigInteger>::value &&
+              std::is_nothrow_move_assignable<BigInteger>::value, "BigInteger moves must not throw");
+
+BigInteger::BigInteger(const std::string &s) {
+    NUMERICAL_OPERATION(OperationParse, s.length());
+    number_.clear();
+
+    if (s.length() == 2 && s[0] == '-' && s[1] == '0') {
+        number_.push_back(0);
+        positive_ = true;
+        return;
+    }
+
+    for (long long i = static_cast<long long>(s.length() - 1); i > 0; --i) {
+        number_.push_back(s[i] - 48);
+    }
+    if (s[0] == '-')
+        positive_ = false;
+    else {
+        number_.push_back(s[0] - 48);
+        positive_ = true;
+    }
+}
+
+BigInteger::~BigInteger() {
+    number_.clear();
+}
+
+BigInteger &BigInteger::operator=(const BigInteger &right) {
+    if (this == &right)
+        return *this;
+
+    copy(right);
+
+    return *this;
+}
+
+// The storage of the two trades places, so `right` hands on what it held.
+BigInteger &BigInteger::operator=(BigInteger &&right) noexcept {
+    if (this != &right) {
+        number_.swap(right.number_);
+        positive_ = right.positive_;
+    }
+
+    return *this;
+}
+
+// Assignment keeps the capacity already held whenever it is enough.
+void BigInteger::copy(const BigInteger &object) {
+    positive_ = object.positive_;
+    number_ = object.number_;
+}
+
+void BigInteger::canonify() {
+    for (long long i = static_cast<long long>(number_.size() - 1); i >= 0; --i)
+        if (number_[i] == 0)
+            number_.pop_back();
+        else
+            break;
+
+    if (size() == 0)
+        number_.push_back(0);
+    if (size() == 1 && number_[0] == 0)
+        positive_ = true;
+}
+
+int BigInteger::compareMagnitudes(const BigInteger &left, const BigInteger &right) {
+    if (left.size() != right.size())
+        return left.size() < right.size() ? -1 : 1;
+    for (size_t i = left.size(); i-- > 0;)
+        if (left.number_[i] != right.number_[i])
+            return left.number_[i] < right.number_[i] ? -1 : 1;
+
+    return 0;
+}
+
+// `result` is resized before the digits are read, so that when it is one of
+// the operands the pointers are taken to its new storage. Every digit is
+// read before the one at the same place is written, which makes the loops
+// safe in place.
+void BigInteger::addSigned(BigInteger &result, const BigInteger &left, const BigInteger &right,
+                           bool rightPositive) {
+    size_t n = left.size(), m = right.size();
+    bool leftPositive = left.positive_;
+
+    if (leftPositive == rightPositive) {
+        result.number_.resize(max(n, m) + 1);
+        const int *a = left.number_.data(), *b = right.number_.data();
+        int *out = result.number_.data(), carry = 0;
+        for (size_t i = 0; i <= max(n, m); ++i) {
+            int digit = (i < n ? a[i] : 0) + (i < m ? b[i] : 0) + carry;
+            carry = digit > 9;
+            out[i] = carry ? digit - 10 : digit;
+        }
+        result.positive_ = leftPositive;
+    } else {
+        int order = compareMagnitudes(left, right);
+        if (order == 0) {
+            result.number_.assign(1, 0);
+            result.positive_ = true;
+            return;
+        }
+        bool positive = order > 0 ? leftPositive : rightPositive;
+        const BigInteger &larger = order > 0 ? left : right, &smaller = order > 0 ? right : left;
+        size_t length = larger.size(), count = smaller.size();
+        result.number_.resize(length);
+        const int *a = larger.number_.data(), *b = smaller.number_.data();
+        int *out = result.number_.data(), borrow = 0;
+        for (size_t i = 0; i < length; ++i) {
+            int digit = a[i] - (i < count ? b[i] : 0) - borrow;
+            borrow = digit < 0;
+            out[i] = borrow ? digit + 10 : digit;
+        }
+        result.positive_ = positive;
+    }
+
+    result.canonify();
+}
+
+void BigInteger::add(BigInteger &result, const BigInteger &left, const BigInteger &right) {
+    NUMERICAL_OPERATION(OperationAdd, max(left.size(), right.size()));
+    addSigned(result, left, right, right.positive_);
+}
+
+void BigInteger::subtract(BigInteger &result, const BigInteger &left, const BigInteger &right) {
+    NUMERICAL_OPERATION(OperationSubtract, max(left.size(), right.size()));
+    addSigned(result, left, right, !right.positive_ || !right);
+}
+
+BigInteger &BigInteger::operator+=(const BigInteger &right) {
+    add(*this, *this, right);
+
+    return *this;
+}
+
+BigInteger &BigInteger::operator-=(const BigInteger &right) {
+    subtract(*this, *this, right);
+
+    return *this;
+}
+
+// Products that would overwrite an operand go to a buffer kept per thread
+// and are copied back, so `result` keeps the storage it already holds. A
+// factor of 10^k only shifts the digits of the other one, and equal factors
+// are squared.
+void BigInteger::multiply(BigInteger &result, const BigInteger &left, const BigInteger &right) {
+    NUMERICAL_OPERATION(OperationMultiply, max(left.size(), right.size()));
+    bool positive = left.positive_ == right.positive_;
+    size_t n = left.size(), m = right.size();
+
+    long long shift = powerOfTen(right);
+    const BigInteger *shifted = &left;
+    if (shift < 0 && (shift = powerOfTen(left)) >= 0)
+        shifted = &right;
+
+    if (shift >= 0) {
+        size_t k = static_cast<size_t>(shift);
+        if (&result == shifted) {
+            result.number_.insert(result.number_.begin(), k, 0);
+        } else {
+            result.number_.assign(k, 0);
+            result.number_.insert(result.number_.end(), shifted->number_.begin(), shifted->number_.end());
+        }
+    } else {
+        const int *a = left.number_.data(), *b = right.number_.data();
+        if (n == m && left.number_ == right.number_)
+            b = a;
+
+        if (&result != &left && &result != &right) {
+            result.number_.resize(n + m);
+            multiplyDigits(a, n, b, m, result.number_.data());
+        } else {
+            DigitVector &product = scratch();
+            product.resize(n + m);
+            multiplyDigits(a, n, b, m, product.data());
+            result.number_.assign(product.begin(), product.end());
+        }
+    }
+    result.positive_ = positive;
+
+    result.canonify();
+}
+
+long long BigInteger::powerOfTen(const BigInteger &value) {
+    size_t n = value.size();
+    if (value.number_[n - 1] != 1)
+        return -1;
+    for (size_t i = 0; i + 1 < n; ++i)
+        if (value.number_[i] != 0)
+            return -1;
+
+    return static_cast<long long>(n - 1);
+}
+
+BigInteger &BigInteger::operator*=(const BigInteger &right) {
+    multiply(*this, *this, right);
+
+    return *this;
+}
+
+// Temporaries of the digit kernels: vectors kept per thread and handed out
+// in stack order, each frame giving back those it took when it ends. They
+// only ever grow, so a loop over operands of steady size allocates nothing
+// once the deepest recursion has run.
+class ScratchFrame {
+public:
+    ScratchFrame() : stack_(stack()), start_(stack_.used) {}
+    ~ScratchFrame() { stack_.used = start_; }
+
+    DigitVector &vector() {
+        if (stack_.used == stack_.vectors.size())
+            stack_.vectors.emplace_back();
+        return stack_.vectors[stack_.used++];
+    }
+
+    // `n` digits of a vector of the frame, zeroed if `zero` is set.
+    int *digits(size_t n, bool zero) {
+        DigitVector &v = vector();
+        if (v.size() < n)
+            v.resize(n);
+        if (zero)
+            std::fill(v.begin(), v.begin() + n, 0);
+        return v.data();
+    }
+
+    // Column sums for the basecase kernels, which call no other kernel.
+    static unsigned long long *columns(size_t n) {
+        static thread_local ColumnVector sums;
+        sums.assign(n, 0);
+        return sums.data();
+    }
+
+private:
+    struct Stack {
+        // A deque keeps the vectors in place as it grows.
+        std::deque<DigitVector> vectors;
+        size_t used;
+    };
+
+    Stack &stack_;
+    size_t start_;
+
+    static Stack &stack() {
+        static thread_local Stack s = Stack();
+        return s;
+    }
+};
+
+void BigInteger::multiplyDigits(const int *a, size_t n, const int *b, size_t m, int *out) {
+    if (a == b && n == m) {
+        squareDigits(a, n, out);
+        return;
+    }
+    if (n < m) {
+        std::swap(a, b);
+        std::swap(n, m);
+    }
+    if (m < max(thresholds().karatsuba, static_cast<size_t>(4)))
+        multiplyBasecase(a, n, b, m, out);
+    else
+        multiplyKaratsuba(a, n, b, m, out);
+}
+
+// Expects n >= m. A multiplier of up to 9 digits, such as any power of two
+// below 2^30, is applied in one pass with the carry in a machine word.
+void BigInteger::multiplyBasecase(const int *a, size_t n, const int *b, size_t m, int *out) {
+    NUMERICAL_TIER(TierMultiplyBasecase);
+    if (m <= 9) {
+        long long multiplier = 0, carry = 0;
+        for (size_t j = m; j-- > 0;)
+            multiplier = multiplier * 10 + b[j];
+        for (size_t i = 0; i < n + m; ++i) {
+            carry += (i < n ? a[i] * multiplier : 0);
+            out[i] = static_cast<int>(carry % 10);
+            carry /= 10;
+        }
+        return;
+    }
+
+    unsigned long long *columns = ScratchFrame::columns(n + m);
+    for (size_t i = 0; i < n; ++i) {
+        if (a[i] == 0)
+            continue;
+        for (size_t j = 0; j < m; ++j)
+            columns[i + j] += static_cast<unsigned long long>(a[i] * b[j]);
+    }
+
+    unsigned long long carry = 0;
+    for (size_t i = 0; i < n + m; ++i) {
+        carry += columns[i];
+        out[i] = static_cast<int>(carry % 10);
+        carry /= 10;
+    }
+}
+
+// Expects n >= m. A much shorter `b` is multiplied by `a` piece by piece;
+// otherwise both are split at half of `a` and the three half-size products
+// are recombined.
+void BigInteger::multiplyKaratsuba(const int *a, size_t n, const int *b, size_t m, int *out) {
+    NUMERICAL_TIER(TierMultiplyKaratsuba);
+    std::fill(out, out + n + m, 0);
+    if (executionCancelled())
+        return;
+
+    ScratchFrame frame;
+    if (2 * m <= n) {
+        int *part = frame.digits(2 * m, false);
+        for (size_t i = 0; i < n; i += m) {
+            size_t length = std::min(m, n - i);
+            multiplyDigits(a + i, length, b, m, part);
+            addDigits(out + i, n + m - i, part, length + m);
+        }
+        return;
+    }
+
+    size_t k = n / 2;
+    size_t lowSize = 2 * k, highSize = n + m - 2 * k;
+    int *low = frame.digits(lowSize, false), *high = frame.digits(highSize, false);
+    multiplyDigits(a, k, b, k, low);
+    multiplyDigits(a + k, n - k, b + k, m - k, high);
+
+    size_t sizeA = n - k + 1, sizeB = max(k, m - k) + 1;
+    int *sumA = frame.digits(sizeA, true), *sumB = frame.digits(sizeB, true);
+    std::copy(a + k, a + n, sumA);
+    addDigits(sumA, sizeA, a, k);
+    std::copy(b + k, b + m, sumB);
+    addDigits(sumB, sizeB, b, k);
+
+    size_t lengthA = sizeA - (sumA[sizeA - 1] == 0), lengthB = sizeB - (sumB[sizeB - 1] == 0);
+    size_t middleSize = sizeA + sizeB;
+    int *middle = frame.digits(middleSize, true);
+    multiplyDigits(sumA, lengthA, sumB, lengthB, middle);
+    subtractDigits(middle, middleSize, low, lowSize);
+    subtractDigits(middle, middleSize, high, highSize);
+
+    size_t used = middleSize;
+    while (used > 0 && middle[used - 1] == 0)
+        --used;
+
+    std::copy(low, low + lowSize, out);
+    std::copy(high, high + highSize, out + 2 * k);
+    addDigits(out + k, n + m - k, middle, used);
+}
+
+void BigInteger::squareDigits(const int *a, size_t n, int *out) {
+    if (n < max(thresholds().karatsubaSquare, static_cast<size_t>(4)))
+        squareBasecase(a, n, out);
+    else
+        squareKaratsuba(a, n, out);
+}
+
+// Each cross product a[i] * a[j], i < j, is taken once and doubled, which
+// halves the digit products of the general case.
+void BigInteger::squareBasecase(const int *a, size_t n, int *out) {
+    NUMERICAL_TIER(TierSquareBasecase);
+    unsigned long long *columns = ScratchFrame::columns(2 * n);
+    for (size_t i = 0; i < n; ++i) {
+        if (a[i] == 0)
+            continue;
+        for (size_t j = i + 1; j < n; ++j)
+            columns[i + j] += static_cast<unsigned long long>(a[i] * a[j]);
+    }
+
+    unsigned long long carry = 0;
+    for (size_t i = 0; i < 2 * n; ++i) {
+        carry += 2 * columns[i] + (i % 2 ? 0 : static_cast<unsigned long long>(a[i / 2] * a[i / 2]));
+        out[i] = static_cast<int>(carry % 10);
+        carry /= 10;
+    }
+}
+
+// Split at half of `a`: the square of each half and of their sum give the
+// cross term, three half-size squarings in all.
+void BigInteger::squareKaratsuba(const int *a, size_t n, int *out) {
+    NUMERICAL_TIER(TierSquareKaratsuba);
+    std::fill(out, out + 2 * n, 0);
+    if (executionCancelled())
+        return;
+
+    ScratchFrame frame;
+    size_t k = n / 2;
+    size_t lowSize = 2 * k, highSize = 2 * (n - k);
+    int *low = frame.digits(lowSize, false), *high = frame.digits(highSize, false);
+    squareDigits(a, k, low);
+    squareDigits(a + k, n - k, high);
+
+    size_t sumSize = n - k + 1;
+    int *sum = frame.digits(sumSize, true);
+    std::copy(a + k, a + n, sum);
+    addDigits(sum, sumSize, a, k);
+
+    size_t length = sumSize - (sum[sumSize - 1] == 0);
+    size_t middleSize = 2 * sumSize;
+    int *middle = frame.digits(middleSize, true);
+    squareDigits(sum, length, middle);
+    subtractDigits(middle, middleSize, low, lowSize);
+    subtractDigits(middle, middleSize, high, highSize);
+
+    size_t used = middleSize;
+    while (used > 0 && middle[used - 1] == 0)
+        --used;
+
+    std::copy(low, low + lowSize, out);
+    std::copy(high, high + highSize, out + 2 * k);
+    addDigits(out + k, 2 * n - k, middle, used);
+}
+
+void BigInteger::addDigits(int *out, size_t length, const int *src, size_t count) {
+    int carry = 0;
+    for (size_t i = 0; i < length && (i < count || carry); ++i) {
+        out[i] += carry + (i < count ? src[i] : 0);
+        carry = out[i] > 9;
+        if (carry)
+            out[i] -= 10;
+    }
+}
+
+void BigInteger::subtractDigits(int *out, size_t length, const int *src, size_t count) {
+    int borrow = 0;
+    for (size_t i = 0; i < length && (i < count || borrow); ++i) {
+        out[i] -= borrow + (i < count ? src[i] : 0);
+        borrow = out[i] < 0;
+        if (borrow)
+            out[i] += 10;
+    }
+}
+
+DigitVector &BigInteger::scratch() {
+    static thread_local DigitVector digits;
+    return digits;
+}
+
+// Schoolbook division in place: `work` starts as the dividend and each step
+// takes a quotient digit off the window of m + 1 digits at its position,
+// which leaves the remainder in the low m digits. The digit is estimated
+// from the leading 18 digits of the window against the leading 17 of the
+// divisor, exact while the divisor has no more than 17 digits and at most
+// one off otherwise, which the corrections after the subtraction take care
+// of. Divisors of up to 9 digits take the short division in a machine word.
+void BigInteger::divideDigits(int *work, size_t n, const int *b, size_t m, int *quotient) {
+    NUMERICAL_TIER(TierDivideBasecase);
+    ProgressReporter progress(n - m + 1);
+
+    if (m <= 9) {
+        long long divisor = 0, remainder = 0;
+        for (size_t i = m; i-- > 0;)
+            divisor = divisor * 10 + b[i];
+        for (size_t i = n; i-- > 0;) {
+            remainder = remainder * 10 + work[i];
+            if (i <= n - m)
+                quotient[i] = static_cast<int>(remainder / divisor);
+            remainder %= divisor;
+            work[i] = 0;
+        }
+        for (size_t i = 0; remainder > 0; ++i, remainder /= 10)
+            work[i] = static_cast<int>(remainder % 10);
+        progress.advance(n - m + 1);
+        return;
+    }
+
+    const size_t leading = 17;
+    size_t used = std::min(m, leading);
+    unsigned long long top = 0;
+    for (size_t j = 0; j < used; ++j)
+        top = top * 10 + static_cast<unsigned long long>(b[m - 1 - j]);
+
+    for (size_t i = n - m + 1; i-- > 0 && !executionCancelled();) {
+        progress.advance();
+        int *window = work + i;
+        unsigned long long head = 0;
+        for (size_t j = 0; j <= used; ++j)
+            head = head * 10 + static_cast<unsigned long long>(window[m - j]);
+        int digit = static_cast<int>(std::min(head / top, 9ULL));
+
+        if (digit > 0) {
+            int borrow = 0;
+            for (size_t j = 0; j <= m; ++j) {
+                int value = window[j] - (j < m ? digit * b[j] : 0) - borrow;
+                borrow = value < 0 ? (9 - value) / 10 : 0;
+                window[j] = value + 10 * borrow;
+            }
+            while (borrow) {
+                --digit;
+                int carry = 0;
+                for (size_t j = 0; j <= m; ++j) {
+                    int value = window[j] + (j < m ? b[j] : 0) + carry;
+                    carry = value > 9;
+                    window[j] = carry ? value - 10 : value;
+                }
+                borrow = !carry;
+            }
+        }
+
+        while (true) {
+            bool smaller = window[m] == 0;
+            if (smaller) {
+                size_t j = m;
+                while (j-- > 0 && window[j] == b[j]) {}
+                smaller = j != static_cast<size_t>(-1) && window[j] < b[j];
+            }
+            if (smaller)
+                break;
+            ++digit;
+            int borrow = 0;
+            for (size_t j = 0; j <= m; ++j) {
+                int value = window[j] - (j < m ? b[j] : 0) - borrow;
+                borrow = value < 0;
+                window[j] = borrow ? value + 10 : value;
+            }
+        }
+        quotient[i] = digit;
+    }
+}
+
+// Truncated division: the quotient is rounded toward zero and the remainder
+// takes the sign of `left`. Either output may be null, and either may be one
+// of the operands, as long as the two outputs are distinct.
+void BigInteger::divideInto(const BigInteger &left, const BigInteger &right, BigInteger *quotient,
+                            BigInteger *remainder) {
+    // A cancelled operation may be left with a zero divisor.
+    if (executionCancelled())
+        return;
+
+    bool quotientPositive = left.positive_ == right.positive_, remainderPositive = left.positive_;
+    if (compareMagnitudes(left, right) < 0) {
+        if (remainder)
+            *remainder = left;
+        if (quotient)
+            *quotient = 0;
+        return;
+    }
+
+    size_t n = left.size(), m = right.size();
+    DigitVector &work = scratch();
+    work.assign(left.number_.begin(), left.number_.end());
+    work.push_back(0);
+
+    bool separate = quotient && quotient != &right && quotient != &left;
+    ScratchFrame frame;
+    DigitVector &digits = separate ? unshared(quotient->number_) : frame.vector();
+    digits.assign(n - m + 1, 0);
+    divideDigits(work.data(), n, right.number_.data(), m, digits.data());
+
+    if (quotient) {
+        if (!separate)
+            quotient->number_.assign(digits.begin(), digits.end());
+        quotient->positive_ = quotientPositive;
+        quotient->canonify();
+    }
+    if (remainder) {
+        remainder->number_.assign(work.begin(), work.begin() + m);
+        remainder->positive_ = remainderPositive;
+        remainder->canonify();
+    }
+}
+
+BigInteger &BigInteger::operator/=(const BigInteger &right) {
+    NUMERICAL_OPERATION(OperationDivide, size());
+    divideInto(*this, right, this, 0);
+
+    return *this;
+}
+
+BigInteger &BigInteger::operator%=(const BigInteger &right) {
+    NUMERICAL_OPERATION(OperationModulo, size());
+    divideInto(*this, right, 0, this);
+
+    return *this;
+}
+
+void BigInteger::divmod(const BigInteger &left, const BigInteger &right, BigInteger &quotient,
+                        BigInteger &remainder) {
+    NUMERICAL_OPERATION(OperationDivide, left.size());
+    divideInto(left, right, &quotient, &remainder);
+}
+
+void BigInteger::reserve(size_t digits) {
+    number_.reserve(digits);
+}
+
+size_t BigInteger::capacity() const {
+    return number_.capacity();
+}
+
+void BigInteger::shrinkToFit() {
+    number_.shrink_to_fit();
+}
+
+bool BigInteger::isPositive() const {
+    return positive_;
+}
+
+bool BigInteger::isNegative() const {
+    return !positive_;
+}
+
+BigInteger BigInteger::abs() const {
+    BigInteger temp(*this);
+    temp.positive_ = true;
+
+    return temp;
+}
+
+BigInteger BigInteger::shiftLeft(size_t count) const {
+    if (!*this || count == 0)
+        return *this;
+
+    BigInteger result;
+    result.positive_ = positive_;
+    result.number_.reserve(size() + count);
+    result.number_.assign(count, 0);
+    result.number_.insert(result.number_.end(), number_.begin(), number_.end());
+
+    return result;
+}
+
+BigInteger BigInteger::shiftRight(size_t count) const {
+    if (size() <= count)
+        return BigInteger(0);
+
+    return BigInteger(number_.data() + count, size() - count, positive_);
+}
+
+std::string BigInteger::toString() const {
+    NUMERICAL_OPERATION(OperationToString, size());
+    std::string s;
+    if (number_.size() == 0) {
+        s = "0";
+        return s;
+    }
+    if (number_.size() == 1 && number_[0] == 0) {
+        s = "0";
+        return s;
+    }
+
+    if (!positive_)
+        s += '-';
+    for (long long i = static_cast<long long>(number_.size() - 1); i >= 0; --i)
+        s += std::to_string(number_[i]);
+
+    return s;
+}
+
+BigInteger::operator bool() const {
+    return !((number_.size() == 1 && number_.at(0) == 0) || number_.size() == 0);
+}
+
+size_t BigInteger::hash() const {
+    unsigned long long h = positive_ ? 0x9e3779b97f4a7c15ULL : 0xc2b2ae3d27d4eb4fULL;
+    for (size_t i = 0; i < number_.size(); i += 9) {
+        unsigned long long word = 0;
+        for (size_t j = std::min(i + 9, number_.size()); j-- > i;)
+            word = word * 10 + number_[j];
+        h = (h ^ word) * 0xff51afd7ed558ccdULL;
+        h ^= h >> 32;
+    }
+
+    return static_cast<size_t>(h);
+}
+
+BigInteger BigInteger::operator-() const {
+    BigInteger temp(*this);
+    temp.positive_ = !temp.positive_;
+
+    if (temp.size() == 0 || (temp.size() == 1 && temp.number_[0] == 0))
+        temp.positive_ = true;
+
+    return temp;
+}
+
+BigInteger &BigInteger::operator--() {
+    return operator-=(1);
+}
+
+BigInteger BigInteger::operator--(int) {
+    BigInteger temp(*this);
+    operator-=(1);
+
+    return temp;
+}
+
+
+BigInteger &BigInteger::operator++() {
+    return operator+=(1);
+}
+
+BigInteger BigInteger::operator++(int) {
+    BigInteger temp(*this);
+    operator+=(1);
+
+    return temp;
+}
+
+bool BigInteger::operator==(const BigInteger &right) const {
+    if (right.number_.size() != number_.size() || positive_ != right.positive_)
+        return false;
+
+    for (size_t i = 0; i < number_.size(); ++i)
+        if (number_[i] != right.number_[i])
+            return false;
+
+    return true;
+}
+
+bool BigInteger::operator!=(const BigInteger &right) const {
+    return !(operator==(right));
+}
+
+bool BigInteger::operator<(const BigInteger &right) const {
+    NUMERICAL_OPERATION(OperationCompare, max(size(), right.size()));
+    if (isNegative() != right.isNegative())
+        return isNegative();
+    if (number_.size() != right.number_.size())
+        return (number_.size() < right.number_.size()) != isNegative();
+    for (long long i = static_cast<long long>(number_.size() - 1); i >= 0; --i)
+        if (number_[i] != right.number_[i])
+            return (number_[i] < right.number_[i]) != isNegative();
+
+    return false;
+}
+
+bool BigInteger::operator>(const BigInteger &right) const {
+    return (right < *this);
+}
+
+bool BigInteger::operator<=(const BigInteger &right) const {
+    return !(operator>(right));
+}
+
+bool BigInteger::operator>=(const BigInteger &right) const {
+    return !(operator<(right));
+}
+
+BigInteger BigInteger::operator+(const BigInteger &right) const {
+    BigInteger result;
+    add(result, *this, right);
+
+    return result;
+}
+
+BigInteger BigInteger::operator-(const BigInteger &right) const {
+    BigInteger result;
+    subtract(result, *this, right);
+
+    return result;
+}
+
+BigInteger BigInteger::operator%(const BigInteger &right) const {
+    NUMERICAL_OPERATION(OperationModulo, size());
+    BigInteger result;
+    divideInto(*this, right, 0, &result);
+
+    return result;
+}
+
+BigInteger BigInteger::operator*(const BigInteger &right) const {
+    BigInteger result;
+    multiply(result, *this, right);
+
+    return result;
+}
+
+BigInteger BigInteger::operator/(const BigInteger &right) const {
+    NUMERICAL_OPERATION(OperationDivide, size());
+    BigInteger result;
+    divideInto(*this, right, &result, 0);
+
+    return result;
+}
+
+std::ostream &operator<<(std::ostream &out, const BigInteger &object) {
+    out << object.toString();
+    return out;
+}
+
+std::istream &operator>>(std::istream &in, BigInteger &object) {
+    std::string s;
+    in >> s;
+    object = BigInteger(s);
+
+    return in;
+}
+
+BigInteger operator+(int n, BigInteger big) {
+    return big + BigInteger(n);
+}
+
+BigInteger operator-(int n, BigInteger big) {
+    return BigInteger(n) - big;
+}
+
+BigInteger operator*(int n, BigInteger big) {
+    return big * BigInteger(n);
+}
+
+BigInteger operator/(int n, BigInteger big) {
+    return BigInteger(n) / big;
+}
+
+BigInteger power(BigInteger base, size_t degree) {
+    BigInteger result(1);
+    while (degree > 0) {
+        if (degree % 2)
+            result *= base;
+        degree /= 2;
+        if (degree > 0)
+            base *= base;
+    }
+
+    return result;
+}
+
+BigInteger gcd(const BigInteger &a, const BigInteger &b) {
+    BigInteger r0(a.abs()), r1(b.abs()), quotient, remainder;
+    while (r1 && !executionCancelled()) {
+        BigInteger::divmod(r0, r1, quotient, remainder);
+        std::swap(r0, r1);
+        std::swap(r1, remainder);
+    }
+
+    return r0;
+}
@@ -0,0 +1,139 @@
+//
+// Created by gosktin on 19.10.26.
+//
+
+#include <cstdlib>
+#include <random>
+
+#include "differential.h"
+#include "random.h"
+#include "rns.h"
+#include "series.h"
+
+// Randomized correctness test: small operands against __int128, long ones
+// through identities, and random bytes through the fuzzer's decoder.
+//
+// usage: check [seed] [rounds]
+
+long long randomSmall(std::mt19937_64 &rng) {
+    static const long long edges[] = {
+            0, 1, -1, 9, 10, -10, 99, 100, 999999999, 1000000000, -1000000000, 4611686018427387903LL,
+            -4611686018427387904LL, 999999999999999999LL, -999999999999999999LL, 1000000000000000000LL
+    };
+
+    switch (rng() % 4) {
+        case 0:
+            return edges[rng() % (sizeof(edges) / sizeof(edges[0]))];
+        case 1:
+            return static_cast<long long>(rng() % 2001) - 1000;
+        case 2:
+            return static_cast<long long>(rng() >> (1 + rng() % 62)) * (rng() % 2 ? 1 : -1);
+        default:
+            return static_cast<long long>(rng() >> 1) * (rng() % 2 ? 1 : -1);
+    }
+}
+
+BigInteger randomLarge(std::mt19937_64 &rng) {
+    size_t length = 1 + rng() % (rng() % 8 == 0 ? 600 : 60);
+    std::string s;
+    switch (rng() % 5) {
+        case 0:
+            s.assign(length, '9');
+            break;
+        case 1:
+            s = "1" + std::string(length - 1, '0');
+            break;
+        case 2:
+            s = std::to_string(rng() % 10);
+            break;
+        default:
+            for (size_t i = 0; i < length; ++i)
+                s += static_cast<char>('0' + rng() % 10);
+    }
+    size_t first = s.find_first_not_of('0');
+    s = first == std::string::npos ? "0" : s.substr(first);
+
+    return BigInteger((rng() % 2 ? "-" : "") + s);
+}
+
+int main(int argc, char **argv) {
+    unsigned long long seed = argc > 1 ? std::strtoull(argv[1], 0, 10) : 20161112;
+    size_t rounds = argc > 2 ? std::strtoull(argv[2], 0, 10) : 2000;
+    std::mt19937_64 rng(seed);
+    // The checks of the higher-level modules draw from a stream of their own,
+    // so adding one leaves the operands of all the others unchanged.
+    std::mt19937_64 moduleRng(seed + 1);
+
+    expect(BigInteger("-0") == BigInteger(0), "-0 == 0", BigInteger("-0"), BigInteger(0));
+    expect(BigInteger("-0").toString() == "0", "toString(-0)", BigInteger("-0"), BigInteger(0));
+    expect(!BigInteger("-0").isNegative(), "-0 is not negative", BigInteger("-0"), BigInteger(0));
+
+    expect(Rational(0.0) == Rational(0) && Rational(-0.0) == Rational(0) &&
+           std::hash<Rational>()(Rational(-0.0)) == std::hash<Rational>()(Rational(0)), "Rational(0.0) == 0",
+           BigInteger(0), BigInteger(0));
+
+    checkAllocations();
+    checkContinuedFraction();
+    checkDecimal();
+    checkReader();
+
+    for (size_t i = 0; i < rounds; ++i)
+        checkSmall(randomSmall(rng), randomSmall(rng));
+    for (size_t i = 0; i < rounds / 10; ++i)
+        checkLarge(randomLarge(rng), randomLarge(rng));
+    for (size_t i = 0; i < rounds / 10; ++i) {
+        std::vector<uint8_t> bytes(rng() % 256);
+        for (size_t j = 0; j < bytes.size(); ++j)
+            bytes[j] = static_cast<uint8_t>(rng());
+        checkBytes(bytes.data(), bytes.size());
+    }
+
+    for (size_t i = 0; i < rounds / 100; ++i) {
+        std::vector<BigInteger> a, b;
+        for (size_t j = rng() % 64; j > 0; --j) {
+            a.push_back(randomLarge(rng));
+            b.push_back(randomLarge(rng));
+        }
+        BigInteger modulus(randomLarge(rng));
+        checkArray(a, b, modulus ? modulus : BigInteger(7), 1 + rng() % 4);
+        checkParallel(a, b, 1 + rng() % 4);
+
+        std::vector<BigInteger> entries;
+        for (size_t j = 0; j < 20; ++j)
+            entries.push_back(BigInteger(static_cast<int>(rng() % 41) - 20));
+        checkMatrix(entries);
+        checkResidues(randomLarge(rng), randomLarge(rng));
+
+        std::vector<BigInteger> coefficients[2];
+        for (int k = 0; k < 2; ++k)
+            for (size_t j = moduleRng() % 12; j > 0; --j)
+                coefficients[k].push_back(BigInteger(std::to_string(randomSmall(moduleRng))));
+        checkPolynomial(coefficients[0], coefficients[1]);
+
+        size_t n = moduleRng() % 500;
+        checkCombinatorics(n, moduleRng() % (n + 2));
+
+        std::vector<int> terms(moduleRng() % 24);
+        for (size_t j = 0; j < terms.size(); ++j)
+            terms[j] = static_cast<int>(moduleRng() % 1000);
+        checkSeries(terms, moduleRng() % 30, randomLarge(moduleRng), randomLarge(moduleRng));
+
+        BigFloat operands[2];
+        for (int k = 0; k < 2; ++k)
+            operands[k] = BigFloat(std::to_string(randomSmall(moduleRng)) + "e" +
+                                   std::to_string(static_cast<int>(moduleRng() % 25) - 12), 40);
+        checkBigFloat(operands[0], operands[1], 1 + moduleRng() % 40, static_cast<RoundingMode>(moduleRng() % 5));
+        checkAsync(randomLarge(moduleRng), randomLarge(moduleRng));
+        checkModular(randomLarge(moduleRng), randomLarge(moduleRng), wordPrimes(1 + moduleRng() % 8).back());
+        checkRandom(randomLarge(moduleRng), moduleRng());
+    }
+    std::mt19937_64 seeded(1);
+    expect(randomDigits(40, seeded) == BigInteger("9930516265689700432462469588189546311528"),
+           "randomDigits from a fixed seed", BigInteger(40), BigInteger(1));
+    expect(piDecimal(50) == "3.14159265358979323846264338327950288419716939937510", "piDecimal", BigInteger(50),
+           BigInteger(50));
+
+    std::cout << differentialFailures << " failures, seed " << seed << std::endl;
+
+    return differentialFailures == 0 ? 0 : 1;
+}
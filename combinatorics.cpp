@@ -0,0 +1,188 @@
+//
+// Created by gosktin on 19.10.26.
+//
+
+#include <algorithm>
+#include <mutex>
+#include <string>
+
+#include "combinatorics.h"
+#include "parallel.h"
+
+// Factors are multiplied together as machine words while they fit in an int.
+static const unsigned long long wordLimit = 2147483647ULL;
+// Products of fewer factors stay on the calling thread.
+static const size_t parallelFactors = 64;
+static const size_t memoizedFactorials = 256;
+
+static BigInteger fromWord(unsigned long long word) {
+    return word <= wordLimit ? BigInteger(static_cast<int>(word)) : BigInteger(std::to_string(word));
+}
+
+// Multiplies `factor` into `word`, moving the word to `factors` first when
+// the product would no longer fit.
+static void multiplyWord(std::vector<BigInteger> &factors, unsigned long long &word, unsigned long long factor) {
+    if (word > 1 && word * factor > wordLimit) {
+        factors.push_back(fromWord(word));
+        word = 1;
+    }
+    word *= factor;
+}
+
+static BigInteger productRange(const std::vector<BigInteger> &factors, size_t begin, size_t end) {
+    if (end - begin == 1)
+        return factors[begin];
+
+    size_t middle = begin + (end - begin) / 2;
+    if (end - begin < parallelFactors)
+        return productRange(factors, begin, middle) * productRange(factors, middle, end);
+
+    BigInteger left;
+    TaskGroup group;
+    group.run([&]() { left = productRange(factors, begin, middle); });
+    BigInteger right(productRange(factors, middle, end));
+    group.wait();
+
+    return left * right;
+}
+
+BigInteger balancedProduct(const std::vector<BigInteger> &factors) {
+    return factors.empty() ? BigInteger(1) : productRange(factors, 0, factors.size());
+}
+
+std::vector<unsigned> primesUpTo(size_t n) {
+    static std::mutex mutex;
+    static std::vector<unsigned> found;
+    static size_t sieved = 1;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (n > sieved) {
+        size_t limit = max(n, 2 * sieved);
+        std::vector<char> composite(limit + 1, 0);
+        found.clear();
+        for (size_t i = 2; i <= limit; ++i) {
+            if (composite[i])
+                continue;
+            found.push_back(static_cast<unsigned>(i));
+            for (size_t j = i * i; j <= limit; j += i)
+                composite[j] = 1;
+        }
+        sieved = limit;
+    }
+
+    return std::vector<unsigned>(found.begin(), std::upper_bound(found.begin(), found.end(), n));
+}
+
+static BigInteger memoizedFactorial(size_t n) {
+    static std::mutex mutex;
+    static std::vector<BigInteger> table(1, BigInteger(1));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    while (table.size() <= n)
+        table.push_back(table.back() * BigInteger(static_cast<int>(table.size())));
+
+    return table[n];
+}
+
+// p divides the swing n! / (n/2)!^2 to the power of the number of odd
+// quotients n / p^i.
+static BigInteger swing(size_t n, const std::vector<unsigned> &primes) {
+    std::vector<BigInteger> factors;
+    unsigned long long word = 1;
+    for (size_t i = 0; i < primes.size() && primes[i] <= n; ++i) {
+        size_t q = n;
+        while (q >= primes[i]) {
+            q /= primes[i];
+            if (q & 1)
+                multiplyWord(factors, word, primes[i]);
+        }
+    }
+    factors.push_back(fromWord(word));
+
+    return balancedProduct(factors);
+}
+
+static BigInteger factorialOf(size_t n, const std::vector<unsigned> &primes) {
+    if (n < memoizedFactorials)
+        return memoizedFactorial(n);
+
+    BigInteger half(factorialOf(n / 2, primes));
+
+    return half * half * swing(n, primes);
+}
+
+BigInteger factorial(size_t n) {
+    if (n < memoizedFactorials)
+        return memoizedFactorial(n);
+
+    return factorialOf(n, primesUpTo(n));
+}
+
+BigInteger binomial(size_t n, size_t k) {
+    if (k > n)
+        return BigInteger(0);
+    k = std::min(k, n - k);
+
+    std::vector<unsigned> primes(primesUpTo(n));
+    std::vector<BigInteger> factors;
+    unsigned long long word = 1;
+    for (size_t i = 0; i < primes.size(); ++i) {
+        size_t p = primes[i], a = k, b = n - k, carry = 0;
+        while (a || b || carry) {
+            carry = a % p + b % p + carry >= p ? 1 : 0;
+            if (carry)
+                multiplyWord(factors, word, p);
+            a /= p;
+            b /= p;
+        }
+    }
+    factors.push_back(fromWord(word));
+
+    return balancedProduct(factors);
+}
+
+// From (F(m), F(m + 1)): F(2m) = F(m) (2 F(m + 1) - F(m)) and
+// F(2m + 1) = F(m)^2 + F(m + 1)^2.
+static void fibonacciPair(size_t n, BigInteger &f, BigInteger &g) {
+    f = 0;
+    g = 1;
+    size_t bit = 1;
+    while (bit <= n / 2)
+        bit <<= 1;
+    for (; bit && n; bit >>= 1) {
+        BigInteger doubled(f * (g * 2 - f)), next(f * f + g * g);
+        if (n & bit) {
+            f = next;
+            g = doubled + next;
+        } else {
+            f = doubled;
+            g = next;
+        }
+    }
+}
+
+BigInteger fibonacci(size_t n) {
+    BigInteger f, g;
+    fibonacciPair(n, f, g);
+
+    return f;
+}
+
+// L(n) = F(n - 1) + F(n + 1) = 2 F(n + 1) - F(n).
+BigInteger lucas(size_t n) {
+    BigInteger f, g;
+    fibonacciPair(n, f, g);
+
+    return g * 2 - f;
+}
+
+BigInteger primorial(size_t n) {
+    std::vector<unsigned> primes(primesUpTo(n));
+    std::vector<BigInteger> factors;
+    unsigned long long word = 1;
+    for (size_t i = 0; i < primes.size(); ++i)
+        multiplyWord(factors, word, primes[i]);
+    factors.push_back(fromWord(word));
+
+    return balancedProduct(factors);
+}
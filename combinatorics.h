@@ -0,0 +1,37 @@
+//
+// Created by gosktin on 19.10.26.
+//
+
+#ifndef COMBINATORICS_H
+#define COMBINATORICS_H
+
+#include <cstddef>
+#include <vector>
+
+#include "biginteger.h"
+
+// The product of all the factors, multiplied in a balanced tree so that the
+// operands of every multiplication are of similar length, which is where
+// Karatsuba pays. The top of the tree runs on the shared thread pool.
+BigInteger balancedProduct(const std::vector<BigInteger> &factors);
+
+// The primes up to n by the sieve of Eratosthenes. The sieve is kept and
+// extended across calls.
+std::vector<unsigned> primesUpTo(size_t n);
+
+// n! from its prime factorization: n! = (n/2)!^2 * swing(n), where the swing
+// is the product of the prime powers dividing n! / (n/2)!^2. Factorials up
+// to a few hundred are memoized.
+BigInteger factorial(size_t n);
+// C(n, k) as the product of p^e over the primes up to n, e being the number
+// of carries when k and n - k are added in base p (Kummer). 0 for k > n.
+BigInteger binomial(size_t n, size_t k);
+
+// F(n) and L(n) by fast doubling, a few multiplications per bit of n.
+BigInteger fibonacci(size_t n);
+BigInteger lucas(size_t n);
+
+// The product of the primes up to n.
+BigInteger primorial(size_t n);
+
+#endif //COMBINATORICS_H
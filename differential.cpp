@@ -0,0 +1,760 @@
+//
+// Created by gosktin on 19.10.26.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include "array.h"
+#include "async.h"
+#include "combinatorics.h"
+#include "differential.h"
+#include "intern.h"
+#include "matrix.h"
+#include "modular.h"
+#include "parallel.h"
+#include "polynomial.h"
+#include "random.h"
+#include "rns.h"
+#include "rational.h"
+#include "reader.h"
+#include "series.h"
+
+size_t differentialFailures = 0;
+
+static std::string toString(__int128 value) {
+    if (value == 0)
+        return "0";
+
+    bool negative = value < 0;
+    unsigned __int128 magnitude = negative ? -static_cast<unsigned __int128>(value) : value;
+    std::string s;
+    while (magnitude > 0) {
+        s += static_cast<char>('0' + static_cast<int>(magnitude % 10));
+        magnitude /= 10;
+    }
+    if (negative)
+        s += '-';
+    std::reverse(s.begin(), s.end());
+
+    return s;
+}
+
+void expect(bool condition, const char *what, const BigInteger &a, const BigInteger &b) {
+    if (condition)
+        return;
+    if (++differentialFailures <= 20)
+        std::cerr << "FAILED " << what << " for a = " << a << ", b = " << b << std::endl;
+}
+
+static void expectEqual(const BigInteger &value, __int128 expected, const char *what, const BigInteger &a,
+                        const BigInteger &b) {
+    expect(value.toString() == toString(expected) && value == BigInteger(toString(expected)), what, a, b);
+}
+
+static int sign(const BigInteger &value) {
+    return !value ? 0 : value.isNegative() ? -1 : 1;
+}
+
+void checkSmall(long long x, long long y) {
+    BigInteger a(toString(x)), b(toString(y));
+    __int128 p = x, q = y;
+
+    expectEqual(a + b, p + q, "a + b", a, b);
+    expectEqual(a - b, p - q, "a - b", a, b);
+    expectEqual(a * b, p * q, "a * b", a, b);
+    expectEqual(-a, -p, "-a", a, b);
+    expectEqual(a.abs(), p < 0 ? -p : p, "abs(a)", a, b);
+
+    BigInteger c(a);
+    c += c;
+    expectEqual(c, p + p, "a += a", a, b);
+    c = a;
+    c -= c;
+    expectEqual(c, 0, "a -= a", a, b);
+    c = a;
+    c *= c;
+    expectEqual(c, p * p, "a *= a", a, b);
+    c = a;
+    expectEqual(++c, p + 1, "++a", a, b);
+    expectEqual(--c, p, "--a", a, b);
+
+    expect((a < b) == (p < q), "a < b", a, b);
+    expect((a > b) == (p > q), "a > b", a, b);
+    expect((a <= b) == (p <= q), "a <= b", a, b);
+    expect((a >= b) == (p >= q), "a >= b", a, b);
+    expect((a == b) == (p == q), "a == b", a, b);
+    expect((a != b) == (p != q), "a != b", a, b);
+    expect(static_cast<bool>(a) == (p != 0), "bool(a)", a, b);
+
+    __int128 g = p < 0 ? -p : p, h = q < 0 ? -q : q;
+    while (h != 0) {
+        __int128 t = g % h;
+        g = h;
+        h = t;
+    }
+    expectEqual(gcd(a, b), g, "gcd(a, b)", a, b);
+
+    if (q != 0) {
+        expectEqual(a / b, p / q, "a / b", a, b);
+        expectEqual(a % b, p % q, "a % b", a, b);
+
+        expect(Rational(x) == Rational(a) && Rational(static_cast<long>(y)) == Rational(b) &&
+               Rational(static_cast<unsigned long long>(q < 0 ? -q : q)) == Rational(b.abs()),
+               "Rational from integers", a, b);
+
+        BigInteger quotient, remainder;
+        BigInteger::divmod(a, b, quotient, remainder);
+        expectEqual(quotient, p / q, "divmod quotient", a, b);
+        expectEqual(remainder, p % q, "divmod remainder", a, b);
+
+        // Rationals with small parts are compared through cross products.
+        Rational r(a, b), s(b, a.abs() + 1);
+        __int128 rn = q < 0 ? -p : p, rd = q < 0 ? -q : q, sn = q, sd = (p < 0 ? -p : p) + 1;
+        expect((r < s) == (rn * sd < sn * rd), "Rational <", a, b);
+        expect((r == s) == (rn * sd == sn * rd), "Rational ==", a, b);
+        expect(r.numerator() == r.p().first && r.denominator() == r.p().second && r.denominator() > 0,
+               "Rational parts", a, b);
+
+        InternTable<Rational> table;
+        Rational scaled(a * 3, b * 3);
+        expect(std::hash<Rational>()(scaled) == std::hash<Rational>()(r), "hash(Rational)", a, b);
+        expect(&table.intern(r) == &table.intern(scaled) && table.size() == 1, "InternTable", a, b);
+
+        std::vector<BigInteger> quotients;
+        ContinuedFraction fraction(r.continuedFraction());
+        for (BigInteger term; fraction.next(term);)
+            quotients.push_back(term);
+        bool positive = true;
+        for (size_t i = 1; i < quotients.size(); ++i)
+            positive = positive && !quotients[i].isNegative() && quotients[i];
+        expect(positive && Rational::fromContinuedFraction(quotients) == r &&
+               Rational(quotients[0]) <= r && r < Rational(quotients[0] + 1), "continued fraction round trip", a, b);
+
+        // No fraction with a denominator up to the limit lies closer: the
+        // distances |a/b - n/d| are compared as |a d - n b| / (|b| d).
+        const int limit = 16;
+        std::pair<BigInteger, BigInteger> best(r.limitDenominator(limit).p());
+        BigInteger numerator(b.isNegative() ? -a : a), denominator(b.abs());
+        BigInteger error((numerator * best.second - best.first * denominator).abs());
+        bool closest = best.second <= limit;
+        for (int d = 1; d <= limit; ++d) {
+            BigInteger nearest(numerator * d / denominator);
+            for (int k = -1; k <= 1; ++k)
+                closest = closest && (numerator * d - (nearest + k) * denominator).abs() * best.second >= error * d;
+        }
+        expect(closest, "limitDenominator is the best approximation", a, b);
+
+        // Both parts exact in a double, so one division rounds correctly.
+        double dx = static_cast<double>(x), dy = static_cast<double>(y);
+        if (x == static_cast<long long>(dx) && y == static_cast<long long>(dy)) {
+            expect(static_cast<double>(r) == dx / dy, "double(Rational)", a, b);
+            double fraction = dx / 1024;
+            expect(Rational(fraction) == Rational(a, 1024) && static_cast<double>(Rational(fraction)) == fraction,
+                   "Rational(double) round trip", a, b);
+
+            // A double across the whole range, the midpoint to the next one,
+            // which rounds to the even of the two, and points just beside it.
+            // The exact sums are long, so only a quarter of the pairs get it.
+            double v = std::ldexp(dx / dy, static_cast<int>((x ^ y) % 1100));
+            double next = std::nextafter(v, v < 0 ? -HUGE_VAL : HUGE_VAL);
+            if (v != 0 && std::isfinite(next) && (x + y) % 4 == 0) {
+                uint64_t pattern;
+                std::memcpy(&pattern, &v, sizeof(pattern));
+                Rational exact(v), above(next), middle((exact + above) * Rational(1, 2)),
+                        nudge((above - exact) * Rational(1, 1000));
+                expect(static_cast<double>(exact) == v && static_cast<double>(middle) == (pattern % 2 ? next : v) &&
+                       static_cast<double>(middle + nudge) == next && static_cast<double>(middle - nudge) == v,
+                       "double(Rational) rounding", a, b);
+            }
+        }
+    }
+}
+
+void checkContinuedFraction() {
+    const struct {
+        long long numerator, denominator;
+        std::vector<int> quotients;
+    } cases[] = {{355, 113, {3, 7, 16}}, {311, 99, {3, 7, 14}}, {-415, 93, {-5, 1, 1, 6, 7}}, {7, 1, {7}}};
+    for (const auto &c : cases) {
+        Rational value(c.numerator, c.denominator);
+        std::vector<BigInteger> expected(c.quotients.begin(), c.quotients.end()), quotients;
+        ContinuedFraction fraction(value.continuedFraction());
+        for (BigInteger term; fraction.next(term);)
+            quotients.push_back(term);
+        expect(quotients == expected && Rational::fromContinuedFraction(expected) == value, "continued fraction",
+               c.numerator, c.denominator);
+    }
+
+    Rational pi(BigInteger("314159265358979"), BigInteger("100000000000000"));
+    expect(pi.limitDenominator(1000) == Rational(355, 113) && pi.limitDenominator(100) == Rational(311, 99) &&
+           Rational(355, 113).limitDenominator(100) == Rational(311, 99), "limitDenominator(pi)", 0, 0);
+    expect(Rational(-415, 93).limitDenominator(10) == Rational(-40, 9) &&
+           Rational(-415, 93).limitDenominator(50) == Rational(-58, 13) &&
+           Rational(-415, 93).limitDenominator(93) == Rational(-415, 93), "limitDenominator(-415/93)", 0, 0);
+}
+
+void checkDecimal() {
+    expect(Rational(5, 2).asDecimal(0, true) == "2" && Rational(-7, 2).asDecimal(0, true) == "-4" &&
+           Rational(999, 1000).asDecimal(2, true) == "1.00" && Rational(999, 1000).asDecimal(2) == "0.99",
+           "asDecimal rounding", 0, 0);
+    expect(Rational(1, 7).asDecimal(12) == "0.142857142857" && Rational(1, 12).asDecimal(6, true) == "0.083333",
+           "asDecimal(1/7), asDecimal(1/12)", 0, 0);
+
+    BigInteger shift("1" + std::string(20, '0'));
+    DecimalExpansion seventh(Rational(1, 7)), twelfth(Rational(1, 12));
+    DecimalExpansion longSeventh(Rational(1, 7 * shift)), longTwelfth(Rational(1, 12 * shift));
+    expect(seventh.preperiod() == 0 && seventh.period(100) == 6 && twelfth.preperiod() == 2 &&
+           twelfth.period(100) == 1, "preperiod and period", 0, 0);
+    expect(longSeventh.preperiod() == 20 && longSeventh.period(100) == 6 && longTwelfth.preperiod() == 22 &&
+           longTwelfth.period(100) == 1 && seventh.period(5) == 0, "preperiod and period, long denominators", 0, 0);
+    // 2.5 - 5 / 10^21, a tie at 20 digits.
+    Rational almost(5 * shift - 1, 2 * shift);
+    expect(almost.asDecimal(0, true) == "2" && almost.asDecimal(20, true) == "2.5" + std::string(19, '0') &&
+           (-almost).asDecimal(21, true) == "-2.499999999999999999995", "asDecimal rounding, long denominators", 0, 0);
+}
+
+void checkReader() {
+    const std::string text = "12 -0 00012\n+7 3x4 5/0 -6/4";
+    std::istringstream integers(text), fractions(text);
+    NumberReader integerReader(integers, 4), fractionReader(fractions, 4);
+
+    std::vector<BigInteger> integerValues;
+    std::vector<ParseError> integerErrors;
+    for (BigInteger value; integerReader.next(value) || integerReader.failed();)
+        if (integerReader.failed())
+            integerErrors.push_back(integerReader.error());
+        else
+            integerValues.push_back(value);
+    expect(integerValues.size() == 4 && integerValues[0] == 12 && !integerValues[1] && !integerValues[1].isNegative() &&
+           integerValues[2] == 12 && integerValues[3] == 7, "NumberReader integers", 0, 0);
+    expect(integerErrors.size() == 3 && integerErrors[0].offset == 16 && integerErrors[0].line == 2 &&
+           integerErrors[0].column == 5 && integerErrors[1].offset == 20, "NumberReader integer errors", 0, 0);
+
+    std::vector<Rational> values;
+    std::vector<ParseError> errors;
+    for (Rational value; fractionReader.next(value) || fractionReader.failed();)
+        if (fractionReader.failed())
+            errors.push_back(fractionReader.error());
+        else
+            values.push_back(value);
+    expect(values.size() == 5 && values[1] == Rational(0) && values[2] == Rational(12) &&
+           values[4] == Rational(-3, 2), "NumberReader fractions", 0, 0);
+    expect(errors.size() == 2 && errors[0].offset == 16 && errors[0].message == "unexpected character 'x'" &&
+           errors[1].offset == 21 && errors[1].line == 2 && errors[1].column == 10 &&
+           errors[1].message == "zero denominator", "NumberReader fraction errors", 0, 0);
+
+    const char *path = "check_reader.txt";
+    std::ofstream(path) << text;
+    std::vector<Rational> read;
+    errors.clear();
+    expect(!readRationals(path, read, errors, 2) && read == values && errors.size() == 2 &&
+           errors[1].column == 10, "readRationals", 0, 0);
+    std::vector<BigInteger> readBack;
+    errors.clear();
+    expect(!readIntegers(path, readBack, errors) && readBack == integerValues && errors.size() == 3, "readIntegers",
+           0, 0);
+    std::remove(path);
+}
+
+void checkAllocations() {
+#ifdef NUMERICAL_INSTRUMENT
+    Thresholds saved = thresholds();
+    thresholds().karatsuba = thresholds().karatsubaSquare = 16;
+    BigInteger a(std::string(300, '7')), b("1" + std::string(199, '3')), product(a * b), square(a * a), d, q, r;
+    bool exact = true;
+    unsigned long long allocations = 0;
+    for (int round = 0; round < 3; ++round) {
+        unsigned long long before = instrumentSnapshot().allocations;
+        for (int i = 0; i < 4; ++i) {
+            BigInteger::multiply(d, a, b);
+            exact = exact && d == product;
+            BigInteger::divmod(d, b, d, r);
+            BigInteger::multiply(q, a, a);
+            exact = exact && q == square;
+            BigInteger::divmod(q, a, q, r);
+            BigInteger::multiply(d, d, b);
+            BigInteger::divmod(d, a, q, r);
+            exact = exact && d == product && q == b && !r;
+        }
+        // The first round is the warm-up.
+        if (round > 0)
+            allocations += instrumentSnapshot().allocations - before;
+    }
+    thresholds() = saved;
+    expect(exact && allocations == 0, "warmed-up in-place arithmetic allocates nothing", a, b);
+#endif
+}
+
+void checkLarge(const BigInteger &a, const BigInteger &b) {
+    BigInteger sum(a + b), difference(a - b), product(a * b);
+
+    expect(sum - b == a, "(a + b) - b == a", a, b);
+    expect(difference == -(b - a), "a - b == -(b - a)", a, b);
+    expect(product == b * a, "a * b == b * a", a, b);
+    expect(a * (b + 1) == product + a, "a * (b + 1) == a * b + a", a, b);
+    expect(sum * sum == a * a + 2 * product + b * b, "(a + b)^2", a, b);
+
+    Thresholds saved = thresholds();
+    thresholds().karatsuba = thresholds().karatsubaSquare = static_cast<size_t>(-1);
+    BigInteger basecase(a * b), basecaseSquare(a * a);
+    thresholds().karatsuba = thresholds().karatsubaSquare = 4;
+    BigInteger karatsuba(a * b), karatsubaSquare(a * a);
+    thresholds() = saved;
+    expect(basecase == product && karatsuba == product, "Karatsuba == basecase", a, b);
+    expect(basecaseSquare == karatsubaSquare && basecaseSquare == a * BigInteger(a.toString()),
+           "square == a * copy of a", a, b);
+
+    BigInteger power(1);
+    size_t shift = b.toString().size() % 7;
+    for (size_t i = shift; i > 0; --i)
+        power *= 10;
+    expect(a * power == BigInteger(a ? a.toString() + power.toString().substr(1) : "0"), "a * 10^k", a, b);
+    expect(a.shiftLeft(shift) == a * power && a.shiftRight(shift) == a / power &&
+           a.shiftLeft(a.size()).shiftRight(a.size()) == a && !a.shiftRight(a.size()), "a shifted by k digits", a, b);
+    expect(a * 1024 == (a * 32) * 32 && a * 1024 - a * 1023 == a, "a * 2^10", a, b);
+
+    expect(BigInteger(a.toString()) == a, "parse(toString(a)) == a", a, b);
+    expect(std::hash<BigInteger>()(BigInteger(a.toString())) == a.hash() && (-a).hash() == (0 - a).hash(),
+           "hash(a)", a, b);
+    expect((a < b) == (sign(difference) < 0), "a < b", a, b);
+    expect((a == b) == (sign(difference) == 0), "a == b", a, b);
+    expect((a < b) + (a == b) + (a > b) == 1, "trichotomy", a, b);
+
+    if (b) {
+        BigInteger quotient(a / b), remainder(a % b);
+        expect(quotient * b + remainder == a, "(a / b) * b + a % b == a", a, b);
+        expect(remainder.abs() < b.abs(), "|a % b| < |b|", a, b);
+        expect(sign(remainder) == 0 || sign(remainder) == sign(a), "sign(a % b)", a, b);
+
+        BigInteger q, r;
+        BigInteger::divmod(a, b, q, r);
+        expect(q == quotient && r == remainder, "divmod == (/, %)", a, b);
+
+        BigInteger x(a), y(b);
+        BigInteger::divmod(x, y, x, y);
+        expect(x == quotient && y == remainder, "divmod into its operands", a, b);
+
+        // More digits than one block of the long division.
+        std::string decimal(Rational(a, b).asDecimal(1500));
+        decimal.erase(std::remove(decimal.begin(), decimal.end(), '.'), decimal.end());
+        decimal.erase(std::remove(decimal.begin(), decimal.end(), '-'), decimal.end());
+        decimal.erase(0, std::min(decimal.find_first_not_of('0'), decimal.size() - 1));
+        expect(BigInteger(decimal) == a.abs() * BigInteger("1" + std::string(1500, '0')) / b.abs(),
+               "asDecimal(a / b) == a * 10^k / b", a, b);
+    }
+
+    std::string text(a.toString());
+    BigInteger copy(a), negated(-a), magnitude(a.abs());
+    copy += 1;
+    negated *= b;
+    BigInteger::multiply(magnitude, magnitude, magnitude);
+    expect(a.toString() == text && copy - 1 == a && negated == -product && magnitude == a * a,
+           "copies are independent", a, b);
+
+    BigInteger x(a);
+    x.reserve(2 * (a.toString().size() + b.toString().size()));
+    size_t capacity = x.capacity();
+    BigInteger::multiply(x, x, b);
+    BigInteger::add(x, x, x);
+    BigInteger::subtract(x, b, x);
+    expect(x == b - 2 * product, "in-place arithmetic", a, b);
+    expect(x.capacity() == capacity, "in-place arithmetic keeps capacity", a, b);
+}
+
+void checkArray(const std::vector<BigInteger> &a, const std::vector<BigInteger> &b, const BigInteger &modulus,
+                unsigned threads) {
+    BigIntegerArray x(a), y(b);
+    ReductionContext context(modulus);
+    std::vector<BigInteger> sums(BigIntegerArray::add(x, y, threads).toVector());
+    std::vector<BigInteger> differences(BigIntegerArray::subtract(x, y, threads).toVector());
+    std::vector<BigInteger> products(BigIntegerArray::multiply(x, y, threads).toVector());
+    std::vector<BigInteger> remainders(BigIntegerArray::mod(x, context, threads).toVector());
+
+    for (size_t i = 0; i < a.size(); ++i) {
+        expect(x[i] == a[i], "BigIntegerArray round trip", a[i], b[i]);
+        expect(sums[i] == a[i] + b[i], "BigIntegerArray::add", a[i], b[i]);
+        expect(differences[i] == a[i] - b[i], "BigIntegerArray::subtract", a[i], b[i]);
+        expect(products[i] == a[i] * b[i], "BigIntegerArray::multiply", a[i], b[i]);
+        expect(remainders[i] == a[i] % modulus, "BigIntegerArray::mod", a[i], modulus);
+        expect(context.reduce(b[i]) == b[i] % modulus, "ReductionContext::reduce", b[i], modulus);
+
+        BigInteger q, r;
+        context.divmod(sums[i], q, r);
+        expect(q * modulus.abs() + r == sums[i] && r.abs() < modulus.abs() &&
+               (!r || r.isNegative() == sums[i].isNegative()), "ReductionContext::divmod", sums[i], modulus);
+    }
+}
+
+void checkParallel(const std::vector<BigInteger> &a, const std::vector<BigInteger> &b, unsigned threads) {
+    ThreadPool pool(threads);
+    BigInteger sum(0), dot(0);
+    std::vector<Rational> fractions;
+    Rational fractionSum(0);
+    for (size_t i = 0; i < a.size(); ++i) {
+        sum += a[i];
+        dot += a[i] * b[i];
+        fractions.push_back(Rational(a[i], BigInteger(static_cast<int>(i % 12) + 1)));
+        fractionSum += fractions.back();
+    }
+    BigInteger first(a.empty() ? BigInteger(0) : a[0]), second(b.empty() ? BigInteger(0) : b[0]);
+
+    expect(parallelSum(a, pool) == sum, "parallelSum", first, second);
+    expect(parallelDot(a, b, pool) == dot, "parallelDot", first, second);
+    expect(parallelSum(fractions, pool) == fractionSum, "parallelSum of Rationals", first, second);
+
+    std::vector<BigInteger> squares;
+    parallelTransform(a, squares, [](const BigInteger &x) { return x * x; }, pool);
+    for (size_t i = 0; i < a.size(); ++i)
+        expect(squares[i] == a[i] * a[i], "parallelTransform", a[i], a[i]);
+
+    std::vector<BigInteger> sorted(b), expected(b);
+    parallelSort(sorted, pool);
+    std::sort(expected.begin(), expected.end());
+    expect(sorted == expected, "parallelSort", first, second);
+}
+
+void checkMatrix(const std::vector<BigInteger> &values) {
+    size_t n = 1;
+    while ((n + 1) * (n + 1) <= values.size())
+        ++n;
+    if (values.size() < n * n + n)
+        return;
+
+    IntegerMatrix integers(n, n);
+    RationalMatrix a(n, n);
+    std::vector<Rational> b(n), x;
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            integers(i, j) = values[i * n + j];
+            a(i, j) = Rational(values[i * n + j], BigInteger(static_cast<int>(i + j + 1)));
+        }
+        b[i] = values[n * n + i];
+    }
+
+    BigInteger determinant(integers.determinant());
+    expect(determinant == integers.determinantModular(), "Bareiss == modular determinant", determinant,
+           BigInteger(static_cast<int>(n)));
+    if (!a.solve(b, x)) {
+        expect(a.determinant() == Rational(0), "solve fails only for singular matrices", determinant, 0);
+        return;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        Rational sum(0);
+        for (size_t j = 0; j < n; ++j)
+            sum += a(i, j) * x[j];
+        expect(sum == b[i], "A * solve(A, b) == b", determinant, BigInteger(static_cast<int>(i)));
+    }
+}
+
+void checkResidues(const BigInteger &a, const BigInteger &b) {
+    PrimeBasis basis(PrimeBasis::primesForDigits(2 * (a.size() + b.size()) + 4));
+    ResidueNumber x(basis, a), y(basis, b);
+    expect(x.toBigInteger() == a, "RNS round trip", a, b);
+    expect((x * y + x - y).toBigInteger() == a * b + a - b, "RNS a * b + a - b", a, b);
+    for (size_t i = 0; i < basis.size(); ++i)
+        expect(x.residues()[i] == residueModulo(a, basis.prime(i)), "RNS residues", a, b);
+
+    Rational expected(a, b ? b.abs() : BigInteger(1)), reconstructed;
+    BigInteger numerator(expected.p().first), denominator(expected.p().second);
+    std::vector<unsigned> residues(basis.size());
+    for (size_t i = 0; i < basis.size(); ++i) {
+        unsigned long long p = basis.prime(i);
+        residues[i] = static_cast<unsigned>(residueModulo(numerator, p) *
+                                            powerModulo(residueModulo(denominator, p), p - 2, p) % p);
+    }
+    BigInteger value(basis.fromResidues(residues.data()));
+    if (value.isNegative())
+        value += basis.modulus();
+    expect(reconstructRational(value, basis.modulus(), reconstructed) && reconstructed == expected,
+           "rational reconstruction", a, b);
+}
+
+void checkPolynomial(const std::vector<BigInteger> &a, const std::vector<BigInteger> &b) {
+    typedef Polynomial<BigInteger> IntegerPolynomial;
+    IntegerPolynomial x(a), y(b);
+    BigInteger n(static_cast<int>(a.size())), m(static_cast<int>(b.size()));
+
+    std::vector<BigInteger> expected(a.size() + b.size(), BigInteger(0));
+    for (size_t i = 0; i < a.size(); ++i)
+        for (size_t j = 0; j < b.size(); ++j)
+            expected[i + j] += a[i] * b[j];
+    expect(x * y == IntegerPolynomial(expected), "polynomial product", n, m);
+
+    std::vector<BigInteger> monic(b);
+    monic.push_back(BigInteger(1));
+    IntegerPolynomial divisor(monic), dividend(x * divisor + y), quotient, remainder;
+    IntegerPolynomial::divmod(dividend, divisor, quotient, remainder);
+    expect(quotient * divisor + remainder == dividend && remainder.degree() < divisor.degree(),
+           "polynomial divmod", n, m);
+
+    // Remainder sequences grow the coefficients, so the gcd gets short ones.
+    std::vector<BigInteger> shortA, shortB;
+    for (size_t i = 0; i < a.size(); ++i)
+        shortA.push_back(a[i] % BigInteger(1000));
+    for (size_t i = 0; i < monic.size(); ++i)
+        shortB.push_back(monic[i] % BigInteger(1000));
+    IntegerPolynomial factor(IntegerPolynomial::linear(BigInteger(2)) * IntegerPolynomial::linear(BigInteger(-3)));
+    IntegerPolynomial u(IntegerPolynomial(shortA) * factor), v(IntegerPolynomial(shortB) * factor);
+    IntegerPolynomial g(IntegerPolynomial::gcd(u, v));
+    expect(IntegerPolynomial::pseudoRemainder(g, factor).isZero() && IntegerPolynomial::pseudoRemainder(u, g).isZero() &&
+           IntegerPolynomial::pseudoRemainder(v, g).isZero(), "polynomial gcd", n, m);
+
+    std::vector<BigInteger> points;
+    for (int i = 0; i < 8; ++i)
+        points.push_back(BigInteger(i * 7 - 20));
+    std::vector<BigInteger> values(x.evaluate(points)), products((x * y).evaluate(points));
+    for (size_t i = 0; i < points.size(); ++i)
+        expect(products[i] == values[i] * y.evaluate(points[i]), "polynomial evaluation", n, m);
+
+    std::vector<Rational> abscissae, ordinates;
+    for (size_t i = 0; i < a.size(); ++i) {
+        abscissae.push_back(Rational(BigInteger(static_cast<int>(3 * i) - 5), BigInteger(static_cast<int>(i % 3 + 1))));
+        ordinates.push_back(Rational(a[i], BigInteger(static_cast<int>(i + 1))));
+    }
+    Polynomial<Rational> through(interpolate(abscissae, ordinates));
+    expect(through.degree() < static_cast<long>(a.size()) && through.evaluate(abscissae) == ordinates,
+           "interpolation", n, m);
+
+    Polynomial<Rational> rationalDivisor(abscissae), rationalQuotient, rationalRemainder;
+    Polynomial<Rational> rationalDividend(Polynomial<Rational>(ordinates) * Polynomial<Rational>(ordinates));
+    Polynomial<Rational>::divmod(rationalDividend, rationalDivisor, rationalQuotient, rationalRemainder);
+    expect(rationalQuotient * rationalDivisor + rationalRemainder == rationalDividend &&
+           rationalRemainder.degree() < max(rationalDivisor.degree(), 0L),
+           "rational polynomial divmod", n, m);
+}
+
+void checkCombinatorics(size_t n, size_t k) {
+    BigInteger a(static_cast<int>(n)), b(static_cast<int>(k));
+    BigInteger product(1), primes(1);
+    std::vector<unsigned> small(primesUpTo(n));
+    for (size_t i = 2; i <= n; ++i) {
+        product *= BigInteger(static_cast<int>(i));
+        if (std::binary_search(small.begin(), small.end(), static_cast<unsigned>(i)))
+            primes *= BigInteger(static_cast<int>(i));
+    }
+    expect(factorial(n) == product, "factorial", a, b);
+    expect(primorial(n) == primes, "primorial", a, b);
+    expect(k > n ? !binomial(n, k) : binomial(n, k) * factorial(k) * factorial(n - k) == product, "binomial", a, b);
+
+    BigInteger f(fibonacci(n)), l(lucas(n));
+    expect(l * l - f * f * 5 == BigInteger(n % 2 ? -4 : 4), "Lucas and Fibonacci", a, b);
+    expect(fibonacci(n + 2) == fibonacci(n + 1) + f, "Fibonacci recurrence", a, b);
+}
+
+void checkModular(const BigInteger &a, const BigInteger &b, unsigned prime) {
+    BigInteger x, y, g(extendedGcd(a, b, x, y));
+    expect(a * x + b * y == g && !g.isNegative() && (!g ? !a && !b : !(a % g) && !(b % g)), "extendedGcd", a, b);
+
+    BigInteger inverse;
+    if (b)
+        expect(modInverse(a, b, inverse) == (g == 1) &&
+               (g != 1 || (!((a * inverse - 1) % b) && !inverse.isNegative() && inverse < b.abs())),
+               "modInverse", a, b);
+
+    BigInteger p(static_cast<int>(prime));
+    unsigned long long euler = powerModulo(residueModulo(a, prime), (prime - 1) / 2, prime);
+    int symbol = kronecker(a, p);
+    expect(symbol == (euler == 0 ? 0 : euler == 1 ? 1 : -1) && symbol == jacobi(a, p), "Kronecker symbol", a, p);
+    if (b)
+        expect(kronecker(a, b * p) == kronecker(a, b) * symbol, "Kronecker multiplicativity", a, b);
+
+    BigInteger goldilocks("18446744069414584321");
+    BigInteger moduli[] = {p, goldilocks};
+    for (size_t i = 0; i < 2; ++i) {
+        ReductionContext context(moduli[i]);
+        BigInteger square((a * a) % moduli[i]), root;
+        expect(modSqrt(square, context, root) && !((root * root - square) % moduli[i]), "modSqrt", a, moduli[i]);
+        expect(powerModulo(a, moduli[i] - 1, context) == (a % moduli[i] ? 1 : 0), "Fermat", a, moduli[i]);
+    }
+    BigInteger root;
+    expect(symbol != -1 || !modSqrt(a, p, root), "modSqrt of a non-square", a, p);
+
+    BigInteger m1(b.abs() + 1), combined, modulus;
+    expect(crtCombine(a % m1, m1, a % p, p, combined, modulus) && modulus == (m1 % p ? m1 * p : m1) &&
+           !((combined - a) % modulus) && !combined.isNegative() && combined < modulus, "crtCombine", a, b);
+    expect(!crtCombine(1, 4, 2, 6, combined, modulus), "inconsistent crtCombine", a, b);
+}
+
+void checkRandom(const BigInteger &bound, unsigned long long seed) {
+    BigInteger b(bound ? bound : BigInteger(1)), limit(power(2, 70));
+    std::mt19937_64 rng(seed), again(seed);
+    std::minstd_rand narrow(static_cast<unsigned>(seed));
+    RandomDigits<std::mt19937_64> source(rng);
+
+    BigIntegerArray batch(randomBelow(b, 50, again));
+    size_t counts[3] = {0, 0, 0};
+    for (size_t i = 0; i < batch.size(); ++i) {
+        BigInteger value(source.below(b)), small(randomBelow(3, narrow));
+        expect(value == batch[i] && !value.isNegative() && value < b.abs(), "randomBelow", value, b);
+        expect(!small.isNegative() && small < 3, "randomBelow with a 31-bit engine", small, b);
+        ++counts[small.raw()[0]];
+    }
+    expect(counts[0] > 5 && counts[1] > 5 && counts[2] > 5, "randomBelow spread",
+           BigInteger(static_cast<int>(counts[0])), BigInteger(static_cast<int>(counts[1])));
+
+    BigInteger bits(randomBits(70, rng)), digits(randomDigits(30, rng));
+    expect(!bits.isNegative() && bits < limit && !digits.isNegative() && digits.toString().size() <= 30,
+           "randomBits and randomDigits", bits, digits);
+
+    Rational low(b.abs(), 3), high(b.abs() + 1, 2), value(randomRational(low, high, b.abs() + 1, rng));
+    expect(!(value < low) && value < high, "randomRational", b, BigInteger(0));
+}
+
+void checkSeries(const std::vector<int> &terms, size_t digits, const BigInteger &a, const BigInteger &b) {
+    HypergeometricSeries series([&](size_t n) { return BigInteger(terms[n] % 7); },
+                                [&](size_t n) { return BigInteger(1 + terms[n] % 5); },
+                                [&](size_t n) { return BigInteger(terms[n] % 11 - 5); },
+                                [&](size_t n) { return BigInteger(1 + terms[n] % 13); });
+    Rational sum(0), product(1);
+    for (size_t n = 0; n < terms.size(); ++n) {
+        product *= Rational(BigInteger(terms[n] % 11 - 5), BigInteger(1 + terms[n] % 13));
+        sum += Rational(BigInteger(terms[n] % 7), BigInteger(1 + terms[n] % 5)) * product;
+    }
+    BigInteger count(static_cast<int>(terms.size()));
+    expect(series.sum(terms.size()) == sum, "HypergeometricSeries::sum", count, count);
+    expect(series.asDecimal(terms.size(), digits) == sum.asDecimal(digits), "HypergeometricSeries::asDecimal",
+           count, count);
+
+    BigInteger square(a * a + b.abs()), root(squareRoot(square));
+    expect(root * root <= square && (root + 1) * (root + 1) > square, "squareRoot", a, b);
+}
+
+// x rounded to `precision` digits straight from the definition: scale |x|
+// to an integer part of exactly `precision` digits and let the remainder
+// decide.
+static BigFloat roundedReference(const Rational &x, size_t precision, RoundingMode mode) {
+    std::pair<BigInteger, BigInteger> p(x.p());
+    if (!p.first)
+        return BigFloat(0);
+
+    bool negative = p.first.isNegative() != p.second.isNegative();
+    long long exponent = static_cast<long long>(p.first.size()) - static_cast<long long>(p.second.size()) -
+                         static_cast<long long>(precision);
+    BigInteger q, r, numerator, denominator;
+    while (true) {
+        numerator = p.first.abs();
+        denominator = p.second.abs();
+        BigInteger &scaled = exponent < 0 ? numerator : denominator;
+        scaled = BigInteger(scaled.toString() + std::string(static_cast<size_t>(absolute(exponent)), '0'));
+        BigInteger::divmod(numerator, denominator, q, r);
+        if (q.size() == precision)
+            break;
+        exponent += q.size() > precision ? 1 : -1;
+    }
+
+    bool up;
+    switch (mode) {
+        case RoundNearestEven:
+            up = r * 2 > denominator || (r * 2 == denominator && q.raw()[0] % 2 == 1);
+            break;
+        case RoundTowardZero:
+            up = false;
+            break;
+        case RoundUpward:
+            up = r && !negative;
+            break;
+        case RoundDownward:
+            up = r && negative;
+            break;
+        default:
+            up = static_cast<bool>(r);
+    }
+    if (up)
+        ++q;
+
+    return BigFloat((negative ? "-" : "") + q.toString() + "e" + std::to_string(exponent), precision + 1);
+}
+
+void checkBigFloat(const BigFloat &a, const BigFloat &b, size_t precision, RoundingMode mode) {
+    Rational x(a.toRational()), y(b.toRational());
+    BigInteger p(static_cast<int>(precision)), m(static_cast<int>(mode));
+    expect(BigFloat(a.toString(), precision + 40) == a, "BigFloat text round trip", a.mantissa(), b.mantissa());
+    expect(BigFloat::add(a, b, precision, mode) == roundedReference(x + y, precision, mode), "BigFloat add", p, m);
+    expect(BigFloat::subtract(a, b, precision, mode) == roundedReference(x - y, precision, mode),
+           "BigFloat subtract", p, m);
+    expect(BigFloat::multiply(a, b, precision, mode) == roundedReference(x * y, precision, mode),
+           "BigFloat multiply", p, m);
+    if (b)
+        expect(BigFloat::divide(a, b, precision, mode) == roundedReference(x / y, precision, mode),
+               "BigFloat divide", p, m);
+    expect(BigFloat(x, precision, mode) == roundedReference(x, precision, mode), "BigFloat from Rational", p, m);
+    // Dropping just the last digit makes a tie whenever that digit is 5.
+    size_t shorter = max<size_t>(a.mantissa().size(), 2) - 1;
+    for (int k = RoundNearestEven; k <= RoundAwayFromZero; ++k)
+        expect(a.withPrecision(shorter, static_cast<RoundingMode>(k)) ==
+               roundedReference(x, shorter, static_cast<RoundingMode>(k)), "BigFloat withPrecision", a.mantissa(),
+               BigInteger(k));
+
+    BigFloat square(a.isNegative() ? -a : a), root(BigFloat::squareRoot(square, precision, RoundTowardZero));
+    Rational low(root.toRational()), ulp(BigFloat("1e" + std::to_string(root.exponent()), 1).toRational()),
+            high(low + ulp), exact(square.toRational());
+    expect(low * low <= exact && high * high > exact, "BigFloat squareRoot", a.mantissa(), p);
+}
+
+void checkAsync(const BigInteger &a, const BigInteger &b) {
+    std::atomic<size_t> done(0), total(0);
+    ProgressCallback progress = [&](size_t d, size_t t) {
+        done = d;
+        total = t;
+    };
+
+    BigInteger product;
+    expect(multiplyAsync(a, b).get(product) && product == a * b, "multiplyAsync", a, b);
+    if (b) {
+        std::pair<BigInteger, BigInteger> result;
+        BigInteger q, r;
+        BigInteger::divmod(a, b, q, r);
+        expect(divmodAsync(a, b, CancellationToken(), progress).get(result) && result.first == q &&
+               result.second == r, "divmodAsync", a, b);
+        std::string text;
+        Rational ratio(a, b);
+        expect(asDecimalAsync(ratio, 50, false, CancellationToken(), progress).get(text) &&
+               text == ratio.asDecimal(50) && done == 50 && total == 50, "asDecimalAsync", a, b);
+    }
+
+    CancellationToken token;
+    token.cancel();
+    expect(!multiplyAsync(a, b, token).get(product), "cancelled multiplyAsync", a, b);
+}
+
+void checkBytes(const uint8_t *data, size_t size) {
+    if (size < 2)
+        return;
+
+    BigInteger operands[2];
+    size_t position = 2;
+    for (int k = 0; k < 2; ++k) {
+        uint8_t shape = data[k];
+        size_t length = 1 + (shape >> 3) % 24 * (shape & 4 ? 16 : 1);
+        std::string digits;
+        for (size_t i = 0; i < length; ++i) {
+            uint8_t byte = position < size ? data[position++] : 0;
+            switch (shape & 3) {
+                case 0:
+                    digits += static_cast<char>('0' + byte % 10);
+                    break;
+                case 1:
+                    digits += '9';
+                    break;
+                case 2:
+                    digits += i == 0 ? '1' : '0';
+                    break;
+                default:
+                    digits += static_cast<char>(i == 0 ? '1' + byte % 9 : '0' + byte % 2 * 9);
+            }
+        }
+        size_t first = digits.find_first_not_of('0');
+        digits = first == std::string::npos ? "0" : digits.substr(first);
+        operands[k] = BigInteger((shape & 128 ? "-" : "") + digits);
+    }
+
+    checkLarge(operands[0], operands[1]);
+}
@@ -0,0 +1,92 @@
+//
+// Created by gosktin on 19.10.26.
+//
+
+#ifndef DIFFERENTIAL_H
+#define DIFFERENTIAL_H
+
+#include <cstdint>
+#include <vector>
+
+#include "bigfloat.h"
+
+// Correctness checks shared by the randomized test and the fuzzer. Values
+// that fit in 64 bits are compared with __int128 arithmetic; longer ones
+// are checked through identities that tie the operations to each other.
+
+extern size_t differentialFailures;
+
+void expect(bool condition, const char *what, const BigInteger &a, const BigInteger &b);
+
+// a and b must fit in 64 bits.
+void checkSmall(long long x, long long y);
+
+// Known expansions and best approximations, including negative values.
+void checkContinuedFraction();
+
+// Ties to even, carries through nines, and where the expansions of 1/7 and
+// 1/12 start repeating, with small and long denominators.
+void checkDecimal();
+
+// A fixed text with signs, leading zeros, a stray character and a zero
+// denominator, through NumberReader and through the file readers.
+void checkReader();
+
+// With NUMERICAL_INSTRUMENT, in-place products, squares and divisions into
+// warmed-up numbers allocate no digits, whichever kernels they run.
+void checkAllocations();
+
+// Identities that hold for operands of any length.
+void checkLarge(const BigInteger &a, const BigInteger &b);
+
+// The batch operations against the scalar ones, element by element.
+void checkArray(const std::vector<BigInteger> &a, const std::vector<BigInteger> &b, const BigInteger &modulus,
+                unsigned threads);
+
+// The parallel helpers against serial loops, on a pool of `threads` workers.
+void checkParallel(const std::vector<BigInteger> &a, const std::vector<BigInteger> &b, unsigned threads);
+
+// Both determinants must agree, and a solution must satisfy the system.
+void checkMatrix(const std::vector<BigInteger> &values);
+
+// Residue arithmetic and rational reconstruction over a basis wide enough
+// for both to be exact.
+void checkResidues(const BigInteger &a, const BigInteger &b);
+
+// Kronecker products against the coefficient-by-coefficient ones, division
+// with remainder, gcds of polynomials with a known common factor and
+// interpolation through values taken back by evaluation.
+void checkPolynomial(const std::vector<BigInteger> &a, const std::vector<BigInteger> &b);
+
+// Factorials against the running product, binomials against factorials and
+// Fibonacci and Lucas numbers through L(n)^2 - 5 F(n)^2 = 4 (-1)^n.
+void checkCombinatorics(size_t n, size_t k);
+
+// The extended gcd through its defining identity, inverses and the
+// Kronecker symbol against Euler's criterion for a word prime, which also
+// checks multiplicativity, square roots of squares modulo the prime and a
+// prime with 2^32 | p - 1, and a CRT combination that must give back a.
+void checkModular(const BigInteger &a, const BigInteger &b, unsigned prime);
+
+// Random values within their ranges, from a 64-bit and a 31-bit engine, a
+// batch equal to the same draws one by one, a rough count of residues and
+// the same values again from the same seed.
+void checkRandom(const BigInteger &bound, unsigned long long seed);
+
+// A series of small random terms against the plain running sum of Rationals,
+// its decimals against Rational::asDecimal, and the root of a^2 + b.
+void checkSeries(const std::vector<int> &terms, size_t digits, const BigInteger &a, const BigInteger &b);
+
+// The four operations against exact Rationals rounded by definition, and the
+// root bracketed by squares.
+void checkBigFloat(const BigFloat &a, const BigFloat &b, size_t precision, RoundingMode mode);
+
+// The asynchronous forms against the plain ones, with the progress ending at
+// its total, and a cancelled token giving no result.
+void checkAsync(const BigInteger &a, const BigInteger &b);
+
+// Builds two operands from arbitrary bytes: the first byte picks the shape
+// of each operand, the rest are spent on digits.
+void checkBytes(const uint8_t *data, size_t size);
+
+#endif //DIFFERENTIAL_H
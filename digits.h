@@ -0,0 +1,112 @@
+//
+// Created by gosktin on 19.10.26.
+//
+
+#ifndef DIGITS_H
+#define DIGITS_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+#include "instrument.h"
+
+// Digit storage of a BigInteger. By default it is the digit vector itself.
+// Built with NUMERICAL_COPY_ON_WRITE, copies share one reference-counted
+// vector, so copying, negating and abs() cost no digit copies, and a shared
+// vector is cloned by the first copy that writes to it. Any non-const access
+// counts as a write: pointers and references from it must not be kept
+// across a copy of the number they came from.
+#ifdef NUMERICAL_COPY_ON_WRITE
+
+class SharedDigits {
+public:
+    typedef DigitVector::value_type value_type;
+    typedef DigitVector::size_type size_type;
+    typedef DigitVector::iterator iterator;
+    typedef DigitVector::const_iterator const_iterator;
+
+    SharedDigits() : digits_(std::make_shared<DigitVector>()) {}
+    SharedDigits(const int *first, const int *last) : digits_(std::make_shared<DigitVector>(first, last)) {}
+
+    operator const DigitVector &() const { return *digits_; }
+
+    size_t size() const { return digits_->size(); }
+    bool empty() const { return digits_->empty(); }
+    size_t capacity() const { return digits_->capacity(); }
+
+    const int &operator[](size_t i) const { return (*digits_)[i]; }
+    int &operator[](size_t i) { return unshared()[i]; }
+    const int &at(size_t i) const { return digits_->at(i); }
+    const int &back() const { return digits_->back(); }
+    int &back() { return unshared().back(); }
+    const int *data() const { return digits_->data(); }
+    int *data() { return unshared().data(); }
+
+    const_iterator begin() const { return digits_->begin(); }
+    const_iterator end() const { return digits_->end(); }
+    iterator begin() { return unshared().begin(); }
+    iterator end() { return unshared().end(); }
+
+    void resize(size_t n, int value = 0) { unshared().resize(n, value); }
+    void reserve(size_t n) { unshared().reserve(n); }
+    void shrink_to_fit() { unshared().shrink_to_fit(); }
+    void push_back(int value) { unshared().push_back(value); }
+    void pop_back() { unshared().pop_back(); }
+    iterator insert(iterator position, size_t n, int value) { return unshared().insert(position, n, value); }
+    template <typename Iterator>
+    iterator insert(iterator position, Iterator first, Iterator last) {
+        return unshared().insert(position, first, last);
+    }
+
+    // Replacing all the digits of a shared vector needs no clone of them.
+    void clear() { overwritten().clear(); }
+    void assign(size_t n, int value) { overwritten().assign(n, value); }
+    template <typename Iterator>
+    void assign(Iterator first, Iterator last) { overwritten().assign(first, last); }
+
+    void swap(SharedDigits &other) noexcept { digits_.swap(other.digits_); }
+
+    bool operator==(const SharedDigits &right) const {
+        return digits_ == right.digits_ || *digits_ == *right.digits_;
+    }
+
+    // The vector of this number alone, cloned first if it is shared.
+    DigitVector &unshared() {
+        if (!digits_)
+            digits_ = std::make_shared<DigitVector>();
+        else if (digits_.use_count() > 1)
+            digits_ = std::make_shared<DigitVector>(*digits_);
+        else
+            std::atomic_thread_fence(std::memory_order_acquire);
+        return *digits_;
+    }
+
+private:
+    // A moved-from number holds no vector until it is written to again.
+    std::shared_ptr<DigitVector> digits_;
+
+    DigitVector &overwritten() {
+        if (!digits_ || digits_.use_count() > 1)
+            digits_ = std::make_shared<DigitVector>();
+        return unshared();
+    }
+};
+
+typedef SharedDigits DigitBuffer;
+
+inline DigitVector &unshared(SharedDigits &digits) {
+    return digits.unshared();
+}
+
+#else
+
+typedef DigitVector DigitBuffer;
+
+inline DigitVector &unshared(DigitVector &digits) {
+    return digits;
+}
+
+#endif
+
+#endif //DIGITS_H
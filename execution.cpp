@@ -0,0 +1,70 @@
+//
+// Created by gosktin on 19.10.26.
+//
+
+#include "execution.h"
+
+static thread_local ExecutionScope *currentScope = 0;
+
+static long long ticks() {
+    return static_cast<long long>(std::chrono::steady_clock::now().time_since_epoch().count());
+}
+
+CancellationToken::CancellationToken() : state_(std::make_shared<State>()) {
+    state_->cancelled = false;
+    state_->deadline = 0;
+}
+
+void CancellationToken::cancel() {
+    state_->cancelled = true;
+}
+
+void CancellationToken::cancelAfter(std::chrono::steady_clock::duration timeout) {
+    state_->deadline = ticks() + static_cast<long long>(timeout.count());
+}
+
+bool CancellationToken::cancelled() const {
+    if (state_->cancelled.load(std::memory_order_relaxed))
+        return true;
+
+    long long deadline = state_->deadline.load(std::memory_order_relaxed);
+    if (deadline == 0 || ticks() < deadline)
+        return false;
+    state_->cancelled = true;
+
+    return true;
+}
+
+ExecutionScope::ExecutionScope(const CancellationToken &token, const ProgressCallback &progress) :
+        token_(token), progress_(progress), reporter_(0), previous_(exchange(this)) {}
+
+ExecutionScope::~ExecutionScope() {
+    exchange(previous_);
+}
+
+ExecutionScope *ExecutionScope::current() {
+    return currentScope;
+}
+
+ExecutionScope *ExecutionScope::exchange(ExecutionScope *scope) {
+    ExecutionScope *previous = currentScope;
+    currentScope = scope;
+
+    return previous;
+}
+
+ProgressReporter::ProgressReporter(size_t total) : scope_(ExecutionScope::current()), total_(total), done_(0) {
+    ProgressReporter *none = 0;
+    if (scope_ && !(scope_->progress_ && scope_->reporter_.compare_exchange_strong(none, this)))
+        scope_ = 0;
+}
+
+ProgressReporter::~ProgressReporter() {
+    if (scope_)
+        scope_->reporter_ = 0;
+}
+
+void ProgressReporter::advance(size_t count) {
+    if (scope_)
+        scope_->progress_(done_ += count, total_);
+}
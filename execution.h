@@ -0,0 +1,95 @@
+//
+// Created by gosktin on 19.10.26.
+//
+
+#ifndef EXECUTION_H
+#define EXECUTION_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+// A cancellation flag shared by all copies of a token, with an optional
+// deadline after which it reads as cancelled by itself.
+class CancellationToken {
+public:
+    CancellationToken();
+
+    void cancel();
+    void cancelAfter(std::chrono::steady_clock::duration timeout);
+    bool cancelled() const;
+
+private:
+    struct State {
+        std::atomic<bool> cancelled;
+        // steady_clock ticks, 0 for none.
+        std::atomic<long long> deadline;
+    };
+
+    std::shared_ptr<State> state_;
+};
+
+// Called with the units done and the units in all, possibly from several
+// pool threads at once.
+typedef std::function<void(size_t, size_t)> ProgressCallback;
+
+class ProgressReporter;
+
+// Makes a token and a progress callback those of every operation run on
+// this thread until the scope ends. TaskGroup hands the scope on to the
+// tasks it runs, so the pool works under it too.
+//
+// Long loops and recursions poll executionCancelled() between steps and
+// return early once it is set, leaving their results unspecified: whoever
+// installed the scope is expected to throw them away.
+class ExecutionScope {
+public:
+    explicit ExecutionScope(const CancellationToken &token, const ProgressCallback &progress = ProgressCallback());
+    ~ExecutionScope();
+
+    ExecutionScope(const ExecutionScope &) = delete;
+    ExecutionScope &operator=(const ExecutionScope &) = delete;
+
+    // The scope of this thread, or null.
+    static ExecutionScope *current();
+    // Installs `scope`, which may be null, and returns the one it replaces.
+    static ExecutionScope *exchange(ExecutionScope *scope);
+
+    bool cancelled() const { return token_.cancelled(); }
+
+private:
+    friend class ProgressReporter;
+
+    CancellationToken token_;
+    ProgressCallback progress_;
+    std::atomic<ProgressReporter *> reporter_;
+    ExecutionScope *previous_;
+};
+
+inline bool executionCancelled() {
+    ExecutionScope *scope = ExecutionScope::current();
+    return scope && scope->cancelled();
+}
+
+// Progress of one operation out of `total` units. Only the outermost
+// reporter of a scope reaches the callback, so the divisions inside an
+// asDecimal do not report over it. advance() may be called from any thread.
+class ProgressReporter {
+public:
+    explicit ProgressReporter(size_t total);
+    ~ProgressReporter();
+
+    ProgressReporter(const ProgressReporter &) = delete;
+    ProgressReporter &operator=(const ProgressReporter &) = delete;
+
+    void advance(size_t count = 1);
+
+private:
+    ExecutionScope *scope_;
+    size_t total_;
+    std::atomic<size_t> done_;
+};
+
+#endif //EXECUTION_H
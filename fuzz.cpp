@@ -0,0 +1,17 @@
+//
+// Created by gosktin on 19.10.26.
+//
+
+#include <cstdlib>
+
+#include "differential.h"
+
+// libFuzzer entry point, built with -DNUMERICAL_FUZZER=ON and clang.
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    checkBytes(data, size);
+    if (differentialFailures)
+        std::abort();
+
+    return 0;
+}
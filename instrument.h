@@ -0,0 +1,257 @@
+//
+// Created by gosktin on 19.10.26.
+//
+
+#ifndef INSTRUMENT_H
+#define INSTRUMENT_H
+
+#include <vector>
+
+// Counters for finding out where time goes inside the library. They are
+// compiled in with -DNUMERICAL_INSTRUMENT; otherwise every hook below
+// expands to nothing and digits are kept in a plain std::vector.
+//
+// Every thread counts into its own block, written only by that thread, so
+// counting needs no atomic read-modify-write. The blocks are linked into a
+// list on first use and never freed, and instrumentSnapshot() sums them
+// with relaxed loads, so counts of finished threads are kept as well.
+//
+// Operations are counted only when called from outside the library: the
+// additions done inside long division, for example, are not counted as
+// additions. The gcd of Rational is the exception and is counted wherever
+// it is called from. Tiers are counted at every level, but their time is
+// taken at the outermost one only, so it adds up to the time of the
+// operations that reached that tier first.
+
+#ifdef NUMERICAL_INSTRUMENT
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <ostream>
+
+enum InstrumentedOperation {
+    OperationAdd,
+    OperationSubtract,
+    OperationMultiply,
+    OperationDivide,
+    OperationModulo,
+    OperationCompare,
+    OperationParse,
+    OperationToString,
+    OperationRationalAdd,
+    OperationRationalMultiply,
+    OperationRationalDivide,
+    OperationRationalCompare,
+    OperationRationalGcd,
+    OperationCount
+};
+
+enum InstrumentedTier {
+    TierMultiplyBasecase,
+    TierMultiplyKaratsuba,
+    TierSquareBasecase,
+    TierSquareKaratsuba,
+    TierDivideBasecase,
+    TierCount
+};
+
+// Operand sizes are binned by the binary logarithm of the digit count.
+const size_t instrumentBuckets = 40;
+
+struct InstrumentSnapshot {
+    unsigned long long calls[OperationCount];
+    unsigned long long sizes[OperationCount][instrumentBuckets];
+    unsigned long long nanoseconds[OperationCount];
+    unsigned long long tierCalls[TierCount];
+    unsigned long long tierNanoseconds[TierCount];
+    unsigned long long allocations;
+    unsigned long long allocatedBytes;
+};
+
+struct InstrumentCounters {
+    std::atomic<unsigned long long> calls[OperationCount];
+    std::atomic<unsigned long long> sizes[OperationCount][instrumentBuckets];
+    std::atomic<unsigned long long> nanoseconds[OperationCount];
+    std::atomic<unsigned long long> tierCalls[TierCount];
+    std::atomic<unsigned long long> tierNanoseconds[TierCount];
+    std::atomic<unsigned long long> allocations;
+    std::atomic<unsigned long long> allocatedBytes;
+
+    unsigned depth;
+    unsigned tierDepth;
+    InstrumentCounters *next;
+};
+
+inline std::atomic<InstrumentCounters *> &instrumentRegistry() {
+    static std::atomic<InstrumentCounters *> head(0);
+    return head;
+}
+
+inline InstrumentCounters &instrumentCounters() {
+    static thread_local InstrumentCounters *counters = 0;
+    if (!counters) {
+        counters = new InstrumentCounters();
+        counters->depth = 0;
+        counters->tierDepth = 0;
+        counters->next = instrumentRegistry().load();
+        while (!instrumentRegistry().compare_exchange_weak(counters->next, counters)) {}
+    }
+
+    return *counters;
+}
+
+// Only the owning thread writes, so a relaxed load and store is enough.
+inline void instrumentAdd(std::atomic<unsigned long long> &counter, unsigned long long value) {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+inline unsigned long long instrumentNow() {
+    return static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+class InstrumentedScope {
+public:
+    InstrumentedScope(InstrumentedOperation operation, size_t digits, bool nested = false) :
+            counters_(instrumentCounters()), operation_(operation), start_(0),
+            counted_(nested || counters_.depth == 0) {
+        ++counters_.depth;
+        if (!counted_)
+            return;
+        size_t bucket = 0;
+        while (digits > 1 && bucket + 1 < instrumentBuckets) {
+            digits /= 2;
+            ++bucket;
+        }
+        instrumentAdd(counters_.calls[operation_], 1);
+        instrumentAdd(counters_.sizes[operation_][bucket], 1);
+        start_ = instrumentNow();
+    }
+
+    ~InstrumentedScope() {
+        --counters_.depth;
+        if (counted_)
+            instrumentAdd(counters_.nanoseconds[operation_], instrumentNow() - start_);
+    }
+
+private:
+    InstrumentCounters &counters_;
+    InstrumentedOperation operation_;
+    unsigned long long start_;
+    bool counted_;
+};
+
+class InstrumentedTierScope {
+public:
+    explicit InstrumentedTierScope(InstrumentedTier tier) : counters_(instrumentCounters()), tier_(tier), start_(0) {
+        instrumentAdd(counters_.tierCalls[tier_], 1);
+        if (counters_.tierDepth++ == 0)
+            start_ = instrumentNow();
+    }
+
+    ~InstrumentedTierScope() {
+        if (--counters_.tierDepth == 0)
+            instrumentAdd(counters_.tierNanoseconds[tier_], instrumentNow() - start_);
+    }
+
+private:
+    InstrumentCounters &counters_;
+    InstrumentedTier tier_;
+    unsigned long long start_;
+};
+
+template <typename T>
+struct CountingAllocator {
+    typedef T value_type;
+
+    CountingAllocator() {}
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U> &) {}
+
+    T *allocate(size_t n) {
+        InstrumentCounters &counters = instrumentCounters();
+        instrumentAdd(counters.allocations, 1);
+        instrumentAdd(counters.allocatedBytes, n * sizeof(T));
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T *p, size_t n) {
+        std::allocator<T>().deallocate(p, n);
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const CountingAllocator<T> &, const CountingAllocator<U> &) {
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const CountingAllocator<T> &, const CountingAllocator<U> &) {
+    return false;
+}
+
+typedef std::vector<int, CountingAllocator<int> > DigitVector;
+// Column sums of the basecase products.
+typedef std::vector<unsigned long long, CountingAllocator<unsigned long long> > ColumnVector;
+
+inline InstrumentSnapshot instrumentSnapshot() {
+    InstrumentSnapshot s = InstrumentSnapshot();
+    for (InstrumentCounters *c = instrumentRegistry().load(); c; c = c->next) {
+        for (size_t i = 0; i < OperationCount; ++i) {
+            s.calls[i] += c->calls[i].load(std::memory_order_relaxed);
+            s.nanoseconds[i] += c->nanoseconds[i].load(std::memory_order_relaxed);
+            for (size_t j = 0; j < instrumentBuckets; ++j)
+                s.sizes[i][j] += c->sizes[i][j].load(std::memory_order_relaxed);
+        }
+        for (size_t i = 0; i < TierCount; ++i) {
+            s.tierCalls[i] += c->tierCalls[i].load(std::memory_order_relaxed);
+            s.tierNanoseconds[i] += c->tierNanoseconds[i].load(std::memory_order_relaxed);
+        }
+        s.allocations += c->allocations.load(std::memory_order_relaxed);
+        s.allocatedBytes += c->allocatedBytes.load(std::memory_order_relaxed);
+    }
+
+    return s;
+}
+
+inline void dumpInstrumentation(std::ostream &out, const InstrumentSnapshot &s) {
+    static const char *operations[OperationCount] = {
+            "add", "subtract", "multiply", "divide", "modulo", "compare", "parse", "toString",
+            "Rational::add", "Rational::multiply", "Rational::divide", "Rational::compare", "Rational::gcd"
+    };
+    static const char *tiers[TierCount] = {"multiply/basecase", "multiply/karatsuba", "square/basecase",
+                                             "square/karatsuba", "divide/basecase"};
+
+    for (size_t i = 0; i < OperationCount; ++i) {
+        if (s.calls[i] == 0)
+            continue;
+        out << operations[i] << ": " << s.calls[i] << " calls, " << s.nanoseconds[i] / 1000 << " us, digits";
+        for (size_t j = 0; j < instrumentBuckets; ++j)
+            if (s.sizes[i][j])
+                out << ' ' << (1ULL << j) << "+:" << s.sizes[i][j];
+        out << '\n';
+    }
+    for (size_t i = 0; i < TierCount; ++i)
+        if (s.tierCalls[i])
+            out << tiers[i] << ": " << s.tierCalls[i] << " calls, " << s.tierNanoseconds[i] / 1000 << " us\n";
+    out << "allocations: " << s.allocations << ", " << s.allocatedBytes << " bytes\n";
+}
+
+#define NUMERICAL_OPERATION(operation, digits) InstrumentedScope instrumentedScope(operation, digits)
+#define NUMERICAL_NESTED_OPERATION(operation, digits) InstrumentedScope instrumentedScope(operation, digits, true)
+#define NUMERICAL_TIER(tier) InstrumentedTierScope instrumentedTierScope(tier)
+
+#else
+
+typedef std::vector<int> DigitVector;
+typedef std::vector<unsigned long long> ColumnVector;
+
+#define NUMERICAL_OPERATION(operation, digits)
+#define NUMERICAL_NESTED_OPERATION(operation, digits)
+#define NUMERICAL_TIER(tier)
+
+#endif
+
+#endif //INSTRUMENT_H
@@ -0,0 +1,28 @@
+//
+// Created by gosktin on 19.10.26.
+//
+
+#include "intern.h"
+
+template <typename T>
+const T &InternTable<T>::intern(const T &value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    return *values_.insert(value).first;
+}
+
+template <typename T>
+size_t InternTable<T>::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    return values_.size();
+}
+
+template <typename T>
+void InternTable<T>::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    values_.clear();
+}
+
+template class InternTable<BigInteger>;
+template class InternTable<Rational>;
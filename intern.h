@@ -0,0 +1,33 @@
+//
+// Created by gosktin on 19.10.26.
+//
+
+#ifndef INTERN_H
+#define INTERN_H
+
+#include <cstddef>
+#include <mutex>
+#include <unordered_set>
+
+#include "rational.h"
+
+// Keeps one copy of every distinct value handed to intern(), so that values
+// met over and over, such as the shared denominators of a matrix, are stored
+// once and interned values compare equal exactly when their addresses do.
+// The table keeps the hash of each value next to it. References stay valid
+// until clear() or the end of the table. Instantiated for BigInteger and
+// Rational; safe to share between threads.
+template <typename T>
+class InternTable {
+public:
+    const T &intern(const T &value);
+
+    size_t size() const;
+    void clear();
+
+private:
+    mutable std::mutex mutex_;
+    std::unordered_set<T> values_;
+};
+
+#endif //INTERN_H
@@ -0,0 +1,272 @@
+//
+// Created by gosktin on 19.10.26.
+//
+
+#include <cmath>
+
+#include "matrix.h"
+#include "parallel.h"
+#include "rns.h"
+
+// Steps updating fewer entries than this stay on the calling thread.
+static const size_t parallelEntries = 64;
+
+// Runs body(begin, end) over [0, count), split into equal parts when the
+// work is large enough.
+static void forEachRow(size_t count, size_t width, const std::function<void(size_t, size_t)> &body) {
+    ThreadPool &pool = ThreadPool::shared();
+    if (count < 2 || count * width < parallelEntries || pool.size() < 2) {
+        body(0, count);
+        return;
+    }
+
+    std::vector<size_t> prefix(count + 1);
+    for (size_t i = 0; i <= count; ++i)
+        prefix[i] = i;
+    forEachRange(splitByCost(prefix, pool.size() + 1), body, pool);
+}
+
+IntegerMatrix::IntegerMatrix() : rows_(0), columns_(0) {}
+
+IntegerMatrix::IntegerMatrix(size_t rows, size_t columns) :
+        rows_(rows), columns_(columns), entries_(rows * columns, BigInteger(0)) {}
+
+IntegerMatrix::IntegerMatrix(const std::vector<std::vector<BigInteger> > &rows) :
+        rows_(rows.size()), columns_(rows.empty() ? 0 : rows[0].size()) {
+    entries_.reserve(rows_ * columns_);
+    for (size_t i = 0; i < rows_; ++i)
+        entries_.insert(entries_.end(), rows[i].begin(), rows[i].end());
+}
+
+void IntegerMatrix::swapRows(size_t a, size_t b) {
+    std::swap_ranges(entries_.begin() + a * columns_, entries_.begin() + (a + 1) * columns_,
+                     entries_.begin() + b * columns_);
+}
+
+size_t IntegerMatrix::eliminate(size_t pivotColumns, int &sign) {
+    sign = 1;
+
+    BigInteger previous(1);
+    size_t rank = 0;
+    for (size_t c = 0; c < pivotColumns && rank < rows_; ++c) {
+        size_t p = rank;
+        while (p < rows_ && !(*this)(p, c))
+            ++p;
+        if (p == rows_)
+            continue;
+        if (p != rank) {
+            swapRows(p, rank);
+            sign = -sign;
+        }
+
+        size_t top = rank;
+        BigInteger pivot((*this)(top, c));
+        bool divide = previous != BigInteger(1);
+        forEachRow(rows_ - top - 1, columns_ - c, [&](size_t begin, size_t end) {
+            for (size_t row = top + 1 + begin; row < top + 1 + end; ++row) {
+                BigInteger factor((*this)(row, c));
+                for (size_t j = c + 1; j < columns_; ++j) {
+                    BigInteger &entry = (*this)(row, j);
+                    entry *= pivot;
+                    if (factor)
+                        entry -= factor * (*this)(top, j);
+                    if (divide)
+                        entry /= previous;
+                }
+                (*this)(row, c) = 0;
+            }
+        });
+
+        ++rank;
+        previous = pivot;
+    }
+
+    return rank;
+}
+
+BigInteger IntegerMatrix::determinant() const {
+    if (rows_ == 0)
+        return BigInteger(1);
+
+    IntegerMatrix copy(*this);
+    int sign;
+    if (copy.eliminate(columns_, sign) < rows_)
+        return BigInteger(0);
+
+    BigInteger last(copy(rows_ - 1, columns_ - 1));
+    return sign < 0 ? -last : last;
+}
+
+size_t IntegerMatrix::rank() const {
+    IntegerMatrix copy(*this);
+    int sign;
+
+    return copy.eliminate(columns_, sign);
+}
+
+// Gaussian elimination over the field of residues modulo a prime below 2^31,
+// so that products fit in 64 bits.
+static unsigned long long determinantModulo(std::vector<unsigned long long> a, size_t n, unsigned long long p) {
+    unsigned long long result = 1;
+    for (size_t c = 0; c < n; ++c) {
+        size_t pivot = c;
+        while (pivot < n && a[pivot * n + c] == 0)
+            ++pivot;
+        if (pivot == n)
+            return 0;
+        if (pivot != c) {
+            std::swap_ranges(a.begin() + pivot * n, a.begin() + (pivot + 1) * n, a.begin() + c * n);
+            result = p - result;
+        }
+
+        result = result * a[c * n + c] % p;
+        unsigned long long inverse = powerModulo(a[c * n + c], p - 2, p);
+        for (size_t row = c + 1; row < n; ++row) {
+            unsigned long long factor = a[row * n + c] * inverse % p;
+            if (factor == 0)
+                continue;
+            for (size_t j = c; j < n; ++j)
+                a[row * n + j] = (a[row * n + j] + (p - factor) * a[c * n + j]) % p;
+        }
+    }
+
+    return result % p;
+}
+
+BigInteger IntegerMatrix::determinantModular() const {
+    size_t n = rows_;
+    if (n == 0)
+        return BigInteger(1);
+
+    // Hadamard: |det| <= product of the row norms <= product of sqrt(n) times
+    // the longest entry of the row.
+    double digits = 1;
+    for (size_t i = 0; i < n; ++i) {
+        size_t longest = 0;
+        for (size_t j = 0; j < n; ++j)
+            if ((*this)(i, j))
+                longest = max(longest, (*this)(i, j).size());
+        if (longest == 0)
+            return BigInteger(0);
+        digits += static_cast<double>(longest) + 0.5 * std::log10(static_cast<double>(n));
+    }
+
+    PrimeBasis basis(PrimeBasis::primesForDigits(static_cast<size_t>(digits)));
+    std::vector<unsigned> residues;
+    parallelTransform(basis.primes(), residues, [this, n](unsigned p) {
+        std::vector<unsigned long long> reduced(n * n);
+        for (size_t k = 0; k < n * n; ++k)
+            reduced[k] = residueModulo(entries_[k], p);
+        return static_cast<unsigned>(determinantModulo(reduced, n, p));
+    });
+
+    return basis.fromResidues(residues.data());
+}
+
+RationalMatrix::RationalMatrix() : rows_(0), columns_(0) {}
+
+RationalMatrix::RationalMatrix(size_t rows, size_t columns) :
+        rows_(rows), columns_(columns), entries_(rows * columns, Rational(0)) {}
+
+RationalMatrix::RationalMatrix(const std::vector<std::vector<Rational> > &rows) :
+        rows_(rows.size()), columns_(rows.empty() ? 0 : rows[0].size()) {
+    entries_.reserve(rows_ * columns_);
+    for (size_t i = 0; i < rows_; ++i)
+        entries_.insert(entries_.end(), rows[i].begin(), rows[i].end());
+}
+
+std::vector<std::vector<Rational> > RationalMatrix::toVectors() const {
+    std::vector<std::vector<Rational> > result(rows_);
+    for (size_t i = 0; i < rows_; ++i)
+        result[i].assign(entries_.begin() + i * columns_, entries_.begin() + (i + 1) * columns_);
+
+    return result;
+}
+
+IntegerMatrix RationalMatrix::scaled(const RationalMatrix *extra, BigInteger *scale) const {
+    size_t added = extra ? extra->columns_ : 0;
+    IntegerMatrix result(rows_, columns_ + added);
+    if (scale)
+        *scale = 1;
+
+    std::vector<std::pair<BigInteger, BigInteger> > row(columns_ + added);
+    for (size_t i = 0; i < rows_; ++i) {
+        BigInteger multiple(1);
+        for (size_t j = 0; j < columns_ + added; ++j) {
+            row[j] = j < columns_ ? (*this)(i, j).p() : (*extra)(i, j - columns_).p();
+            if (row[j].second != multiple)
+                multiple = multiple / gcd(multiple, row[j].second) * row[j].second;
+        }
+        for (size_t j = 0; j < columns_ + added; ++j)
+            result(i, j) = row[j].second == multiple ? row[j].first : row[j].first * (multiple / row[j].second);
+        if (scale)
+            *scale *= multiple;
+    }
+
+    return result;
+}
+
+Rational RationalMatrix::determinant(bool modular) const {
+    BigInteger scale;
+    IntegerMatrix m(scaled(0, &scale));
+
+    return Rational(modular ? m.determinantModular() : m.determinant(), scale);
+}
+
+size_t RationalMatrix::rank() const {
+    return scaled(0, 0).rank();
+}
+
+// After fraction-free elimination of [A | B] the system reads U X = C with
+// the determinant d of the permuted A as the last pivot. By Cramer's rule
+// Y = d X is integral, so back substitution on Y divides exactly and the
+// only gcds are taken when the results become Rationals.
+bool RationalMatrix::solveColumns(const RationalMatrix &b, RationalMatrix &x) const {
+    size_t n = rows_, k = b.columns_;
+    IntegerMatrix m(scaled(&b, 0));
+    int sign;
+    if (n != columns_ || m.eliminate(n, sign) < n)
+        return false;
+
+    BigInteger d(n ? m(n - 1, n - 1) : BigInteger(1));
+    x = RationalMatrix(n, k);
+    forEachRow(k, n * n, [&](size_t begin, size_t end) {
+        std::vector<BigInteger> y(n);
+        for (size_t column = begin; column < end; ++column) {
+            for (size_t i = n; i > 0; --i) {
+                size_t row = i - 1;
+                BigInteger sum(d * m(row, n + column));
+                for (size_t j = row + 1; j < n; ++j)
+                    if (m(row, j))
+                        sum -= m(row, j) * y[j];
+                y[row] = sum / m(row, row);
+            }
+            for (size_t i = 0; i < n; ++i)
+                x(i, column) = Rational(y[i], d);
+        }
+    });
+
+    return true;
+}
+
+bool RationalMatrix::solve(const std::vector<Rational> &b, std::vector<Rational> &x) const {
+    RationalMatrix column(b.size(), 1), result;
+    for (size_t i = 0; i < b.size(); ++i)
+        column(i, 0) = b[i];
+    if (b.size() != rows_ || !solveColumns(column, result))
+        return false;
+
+    x.resize(rows_);
+    for (size_t i = 0; i < rows_; ++i)
+        x[i] = result(i, 0);
+
+    return true;
+}
+
+bool RationalMatrix::inverse(RationalMatrix &result) const {
+    RationalMatrix identity(rows_, rows_);
+    for (size_t i = 0; i < rows_; ++i)
+        identity(i, i) = 1;
+
+    return solveColumns(identity, result);
+}
@@ -0,0 +1,90 @@
+//
+// Created by gosktin on 19.10.26.
+//
+
+#ifndef MATRIX_H
+#define MATRIX_H
+
+#include <cstddef>
+#include <vector>
+
+#include "rational.h"
+
+// Integer matrix with its entries stored row after row in one vector.
+//
+// Elimination is fraction-free (Bareiss): every step divides exactly by the
+// previous pivot, so the entries stay minors of the original matrix and grow
+// linearly in the number of rows instead of exponentially, and no gcd is ever
+// taken. Rows below the pivot are updated in parallel once the step is large
+// enough to pay for it.
+class IntegerMatrix {
+public:
+    IntegerMatrix();
+    IntegerMatrix(size_t rows, size_t columns);
+    explicit IntegerMatrix(const std::vector<std::vector<BigInteger> > &rows);
+
+    size_t rows() const { return rows_; }
+    size_t columns() const { return columns_; }
+
+    BigInteger &operator()(size_t row, size_t column) { return entries_[row * columns_ + column]; }
+    const BigInteger &operator()(size_t row, size_t column) const { return entries_[row * columns_ + column]; }
+
+    // The matrix must be square.
+    BigInteger determinant() const;
+    // Same value, computed modulo enough word-sized primes to cover the
+    // Hadamard bound and put together over a PrimeBasis. The intermediate
+    // values never grow, which wins for large matrices with short entries.
+    BigInteger determinantModular() const;
+
+    size_t rank() const;
+
+    // Brings the matrix to fraction-free row echelon form in place and
+    // returns the rank. Only the first `pivotColumns` columns are searched
+    // for pivots; the others are carried along. When those columns form a
+    // nonsingular square, the last pivot is `sign` times their determinant.
+    size_t eliminate(size_t pivotColumns, int &sign);
+
+private:
+    size_t rows_;
+    size_t columns_;
+    std::vector<BigInteger> entries_;
+
+    void swapRows(size_t a, size_t b);
+};
+
+class RationalMatrix {
+public:
+    RationalMatrix();
+    RationalMatrix(size_t rows, size_t columns);
+    explicit RationalMatrix(const std::vector<std::vector<Rational> > &rows);
+
+    size_t rows() const { return rows_; }
+    size_t columns() const { return columns_; }
+
+    Rational &operator()(size_t row, size_t column) { return entries_[row * columns_ + column]; }
+    const Rational &operator()(size_t row, size_t column) const { return entries_[row * columns_ + column]; }
+
+    Rational determinant(bool modular = false) const;
+    size_t rank() const;
+
+    // Solves A x = b for a square A; false if A is singular.
+    bool solve(const std::vector<Rational> &b, std::vector<Rational> &x) const;
+    // False if the matrix is singular.
+    bool inverse(RationalMatrix &result) const;
+
+    std::vector<std::vector<Rational> > toVectors() const;
+
+private:
+    size_t rows_;
+    size_t columns_;
+    std::vector<Rational> entries_;
+
+    // Every row times the lcm of its denominators, followed by the columns
+    // of `extra` scaled the same way; `scale` receives the product of the
+    // multipliers.
+    IntegerMatrix scaled(const RationalMatrix *extra, BigInteger *scale) const;
+    // Solves A X = B for all columns of B at once.
+    bool solveColumns(const RationalMatrix &b, RationalMatrix &x) const;
+};
+
+#endif //MATRIX_H
@@ -0,0 +1,237 @@
+//
+// Created by gosktin on 19.10.26.
+//
+
+#include <algorithm>
+#include <utility>
+
+#include "execution.h"
+#include "modular.h"
+
+// |value| mod 10^4, enough for its residues mod 2, 4, 8 and 16.
+static unsigned lowDigits(const BigInteger &value) {
+    const DigitVector &digits = value.raw();
+    unsigned low = 0;
+    for (size_t i = std::min(digits.size(), static_cast<size_t>(4)); i-- > 0;)
+        low = low * 10 + static_cast<unsigned>(digits[i]);
+
+    return low;
+}
+
+static bool isEven(const BigInteger &value) {
+    return value.raw()[0] % 2 == 0;
+}
+
+// value mod 8 in [0, 8) whatever the sign.
+static unsigned residueEight(const BigInteger &value) {
+    unsigned low = lowDigits(value) % 8;
+    return value.isNegative() ? (8 - low) % 8 : low;
+}
+
+// Strips the factors of two off a nonzero `value` and returns whether
+// their count is odd.
+static bool removeTwos(BigInteger &value) {
+    bool odd = false;
+    while (lowDigits(value) % 4 == 0)
+        value /= 4;
+    if (isEven(value)) {
+        value /= 2;
+        odd = true;
+    }
+
+    return odd;
+}
+
+static BigInteger residue(const BigInteger &value, const ReductionContext &context) {
+    BigInteger result(context.reduce(value));
+    if (result.isNegative())
+        result += context.modulus().abs();
+
+    return result;
+}
+
+// result = left * right mod the modulus, for residues in [0, |modulus|).
+static void multiplyModulo(BigInteger &result, const BigInteger &left, const BigInteger &right,
+                           const ReductionContext &context) {
+    BigInteger::multiply(result, left, right);
+    result = context.reduce(result);
+}
+
+BigInteger extendedGcd(const BigInteger &a, const BigInteger &b, BigInteger &x, BigInteger &y) {
+    BigInteger r0(a.abs()), r1(b.abs()), s0(1), s1(0), q, r;
+    while (r1 && !executionCancelled()) {
+        BigInteger::divmod(r0, r1, q, r);
+        std::swap(r0, r1);
+        std::swap(r1, r);
+        BigInteger::multiply(r, q, s1);
+        BigInteger::subtract(r, s0, r);
+        std::swap(s0, s1);
+        std::swap(s1, r);
+    }
+
+    // s0 is the coefficient of |a|; the one of |b| follows from it.
+    BigInteger t(0);
+    if (b)
+        t = (r0 - a.abs() * s0) / b.abs();
+    if (a.isNegative())
+        s0 = -s0;
+    if (b.isNegative())
+        t = -t;
+    x = s0;
+    y = t;
+
+    return r0;
+}
+
+// Left to right over the decimal digits of the exponent: the result so far
+// is raised to the tenth power, ((r^2)^2 * r)^2, and multiplied by the power
+// of the base for the next digit, taken from a table of ten.
+BigInteger powerModulo(const BigInteger &base, const BigInteger &exponent, const ReductionContext &context) {
+    BigInteger table[10];
+    table[0] = residue(1, context);
+    table[1] = residue(base, context);
+    for (int d = 2; d < 10; ++d)
+        multiplyModulo(table[d], table[d - 1], table[1], context);
+
+    const DigitVector &digits = exponent.raw();
+    BigInteger result(table[0]), square;
+    for (size_t i = digits.size(); i-- > 0 && !executionCancelled();) {
+        if (i + 1 < digits.size()) {
+            multiplyModulo(square, result, result, context);
+            multiplyModulo(square, square, square, context);
+            multiplyModulo(result, square, result, context);
+            multiplyModulo(result, result, result, context);
+        }
+        if (digits[i])
+            multiplyModulo(result, result, table[digits[i]], context);
+    }
+
+    return result;
+}
+
+bool modInverse(const BigInteger &a, const BigInteger &modulus, BigInteger &inverse) {
+    BigInteger m(modulus.abs()), x, y;
+    if (extendedGcd(a % m, m, x, y) != 1)
+        return false;
+
+    x %= m;
+    if (x.isNegative())
+        x += m;
+    inverse = x;
+
+    return true;
+}
+
+// Reciprocity on the pair (x, m): twos come off x with (2 / m) = -1 for
+// m = 3, 5 mod 8, and swapping the two flips the sign when both are 3 mod 4.
+int jacobi(const BigInteger &a, const BigInteger &n) {
+    BigInteger m(n), x(a % n), quotient;
+    if (x.isNegative())
+        x += m;
+
+    int t = 1;
+    while (x && !executionCancelled()) {
+        if (removeTwos(x)) {
+            unsigned r = lowDigits(m) % 8;
+            if (r == 3 || r == 5)
+                t = -t;
+        }
+        std::swap(x, m);
+        if (lowDigits(x) % 4 == 3 && lowDigits(m) % 4 == 3)
+            t = -t;
+        BigInteger::divmod(x, m, quotient, x);
+    }
+
+    return m == 1 ? t : 0;
+}
+
+int kronecker(const BigInteger &a, const BigInteger &n) {
+    if (!n)
+        return a.abs() == 1 ? 1 : 0;
+
+    int t = n.isNegative() && a.isNegative() ? -1 : 1;
+    BigInteger m(n.abs());
+    if (isEven(m)) {
+        if (isEven(a))
+            return 0;
+        unsigned r = residueEight(a);
+        if (removeTwos(m) && (r == 3 || r == 5))
+            t = -t;
+    }
+
+    return t * jacobi(a, m);
+}
+
+// p - 1 = q 2^s. With s = 1 the root is a^((p + 1) / 4); otherwise the
+// candidate a^((q + 1) / 2) is corrected by powers of c = z^q, z being a
+// non-square, until t = a^q, the error, reaches 1. A modulus that turns
+// out not to be prime on the way gives false.
+bool modSqrt(const BigInteger &a, const ReductionContext &prime, BigInteger &root) {
+    BigInteger p(prime.modulus().abs()), x(residue(a, prime));
+    if (!x || p == 2) {
+        root = x;
+        return true;
+    }
+    if (isEven(p) || jacobi(x, p) != 1)
+        return false;
+
+    BigInteger q(p - 1);
+    size_t s = 0;
+    while (isEven(q)) {
+        q /= 2;
+        ++s;
+    }
+    if (s == 1) {
+        root = powerModulo(x, (p + 1) / 4, prime);
+        return true;
+    }
+
+    BigInteger z(2);
+    while (jacobi(z, p) != -1)
+        if (++z == p || executionCancelled())
+            return false;
+
+    BigInteger c(powerModulo(z, q, prime)), t(powerModulo(x, q, prime)), r(powerModulo(x, (q + 1) / 2, prime));
+    BigInteger u, b;
+    while (t != 1) {
+        size_t i = 0;
+        for (u = t; u != 1 && i < s; ++i)
+            multiplyModulo(u, u, u, prime);
+        if (i == s || executionCancelled())
+            return false;
+
+        b = c;
+        for (size_t j = i + 1; j < s; ++j)
+            multiplyModulo(b, b, b, prime);
+        s = i;
+        multiplyModulo(c, b, b, prime);
+        multiplyModulo(t, t, c, prime);
+        multiplyModulo(r, r, b, prime);
+    }
+    root = r;
+
+    return true;
+}
+
+bool modSqrt(const BigInteger &a, const BigInteger &prime, BigInteger &root) {
+    return modSqrt(a, ReductionContext(prime), root);
+}
+
+// With g = gcd(m1, m2) = m1 u + m2 v, the solution is a1 + m1 k for
+// k = (a2 - a1) / g * u mod m2 / g.
+bool crtCombine(const BigInteger &a1, const BigInteger &m1, const BigInteger &a2, const BigInteger &m2,
+                BigInteger &x, BigInteger &modulus) {
+    BigInteger u, v, g(extendedGcd(m1, m2, u, v)), quotient, remainder;
+    BigInteger::divmod(a2 - a1, g, quotient, remainder);
+    if (remainder)
+        return false;
+
+    BigInteger step(m2 / g), lcm(m1 * step);
+    BigInteger k(quotient * u % step), result((a1 + m1 * k) % lcm);
+    if (result.isNegative())
+        result += lcm;
+    x = result;
+    modulus = lcm;
+
+    return true;
+}
@@ -0,0 +1,42 @@
+//
+// Created by gosktin on 19.10.26.
+//
+
+#ifndef MODULAR_H
+#define MODULAR_H
+
+#include "array.h"
+
+// Modular arithmetic on BigIntegers. A fixed modulus comes as a
+// ReductionContext, which callers working in a loop build once; the
+// overloads taking the modulus itself build a context per call. Residues
+// are returned in [0, |modulus|).
+
+// g = gcd(a, b) >= 0 together with x and y such that a * x + b * y = g.
+// The Euclidean steps take quotient and remainder from one division each.
+BigInteger extendedGcd(const BigInteger &a, const BigInteger &b, BigInteger &x, BigInteger &y);
+
+// base^exponent mod the context's modulus for exponent >= 0, one decimal
+// digit of the exponent at a time.
+BigInteger powerModulo(const BigInteger &base, const BigInteger &exponent, const ReductionContext &context);
+
+// a^-1 mod modulus; false, leaving `inverse` alone, if gcd(a, modulus) != 1.
+// `modulus` must not be zero.
+bool modInverse(const BigInteger &a, const BigInteger &modulus, BigInteger &inverse);
+
+// The Jacobi symbol (a / n) for odd positive n, and the Kronecker symbol,
+// which extends it to every n. Both are 0, 1 or -1.
+int jacobi(const BigInteger &a, const BigInteger &n);
+int kronecker(const BigInteger &a, const BigInteger &n);
+
+// A root r of r^2 = a modulo a prime, by Tonelli-Shanks, or false if a is
+// not a square. The modulus is not checked for primality.
+bool modSqrt(const BigInteger &a, const ReductionContext &prime, BigInteger &root);
+bool modSqrt(const BigInteger &a, const BigInteger &prime, BigInteger &root);
+
+// The x mod lcm(m1, m2) with x = a1 mod m1 and x = a2 mod m2, for positive
+// moduli that need not be coprime; false if the two disagree.
+bool crtCombine(const BigInteger &a1, const BigInteger &m1, const BigInteger &a2, const BigInteger &m2,
+                BigInteger &x, BigInteger &modulus);
+
+#endif //MODULAR_H
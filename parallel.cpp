@@ -0,0 +1,166 @@
+//
+// Created by gosktin on 19.10.26.
+//
+
+#include <chrono>
+
+#include "execution.h"
+#include "parallel.h"
+
+// Index of the worker running on this thread, or -1 on any other thread.
+static thread_local int currentWorker = -1;
+
+ThreadPool::ThreadPool(unsigned threads) : pending_(0), next_(0), stopping_(false) {
+    if (threads == 0)
+        threads = max(std::thread::hardware_concurrency(), 1u);
+
+    for (unsigned i = 0; i < threads; ++i)
+        queues_.push_back(std::unique_ptr<Queue>(new Queue()));
+    for (unsigned i = 0; i < threads; ++i)
+        workers_.push_back(std::thread(&ThreadPool::work, this, i));
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (size_t i = 0; i < workers_.size(); ++i)
+        workers_[i].join();
+}
+
+ThreadPool &ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+// A worker queues onto its own deque, so the tasks it splits off stay local
+// unless somebody is idle; other threads deal tasks round robin.
+void ThreadPool::submit(const std::function<void()> &task) {
+    unsigned index = currentWorker >= 0 ? static_cast<unsigned>(currentWorker) : next_++ % size();
+    {
+        std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+        queues_[index]->tasks.push_back(task);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++pending_;
+    }
+    wake_.notify_one();
+}
+
+bool ThreadPool::take(unsigned index, std::function<void()> &task) {
+    {
+        std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+        if (!queues_[index]->tasks.empty()) {
+            task = queues_[index]->tasks.back();
+            queues_[index]->tasks.pop_back();
+            --pending_;
+            return true;
+        }
+    }
+    for (unsigned k = 1; k < size(); ++k) {
+        Queue &victim = *queues_[(index + k) % size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            --pending_;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool ThreadPool::runPending() {
+    std::function<void()> task;
+    unsigned index = currentWorker >= 0 ? static_cast<unsigned>(currentWorker) : next_++ % size();
+    if (!take(index, task))
+        return false;
+    task();
+
+    return true;
+}
+
+void ThreadPool::work(unsigned index) {
+    currentWorker = static_cast<int>(index);
+    std::function<void()> task;
+    while (true) {
+        if (take(index, task)) {
+            task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_.wait(lock, [this]() { return stopping_ || pending_ > 0; });
+        if (stopping_ && pending_ == 0)
+            return;
+    }
+}
+
+TaskGroup::TaskGroup(ThreadPool &pool) : pool_(pool), remaining_(0) {}
+
+TaskGroup::~TaskGroup() {
+    wait();
+}
+
+// The task runs under the execution scope of the thread that adds it, which
+// outlives it since that thread waits for the group; once the scope is
+// cancelled, tasks still queued are skipped.
+void TaskGroup::run(const std::function<void()> &task) {
+    ++remaining_;
+    ExecutionScope *scope = ExecutionScope::current();
+    pool_.submit([this, task, scope]() {
+        ExecutionScope *previous = ExecutionScope::exchange(scope);
+        if (!scope || !scope->cancelled())
+            task();
+        ExecutionScope::exchange(previous);
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--remaining_ == 0)
+            done_.notify_all();
+    });
+}
+
+// Waiting threads keep running pending tasks, which may belong to other
+// groups, and only sleep once there is nothing left to take.
+void TaskGroup::wait() {
+    while (remaining_ > 0) {
+        if (pool_.runPending())
+            continue;
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait_for(lock, std::chrono::milliseconds(1), [this]() { return remaining_ == 0; });
+    }
+    // The last task may still hold the lock it counted down under.
+    std::lock_guard<std::mutex> lock(mutex_);
+}
+
+std::vector<size_t> splitByCost(const std::vector<size_t> &prefix, size_t chunks) {
+    size_t count = prefix.size() - 1, total = prefix.back();
+    std::vector<size_t> splits(1, 0);
+    for (size_t k = 1; k < chunks && total > 0; ++k) {
+        size_t split = static_cast<size_t>(
+                std::lower_bound(prefix.begin(), prefix.end(), total * k / chunks) - prefix.begin());
+        if (split > splits.back() && split < count)
+            splits.push_back(split);
+    }
+    if (count > 0)
+        splits.push_back(count);
+
+    return splits;
+}
+
+void forEachRange(const std::vector<size_t> &splits, const std::function<void(size_t, size_t)> &body,
+                  ThreadPool &pool) {
+    if (splits.size() < 2)
+        return;
+
+    TaskGroup group(pool);
+    for (size_t k = 1; k + 1 < splits.size(); ++k) {
+        size_t begin = splits[k], end = splits[k + 1];
+        group.run([&body, begin, end]() { body(begin, end); });
+    }
+    body(splits[0], splits[1]);
+    group.wait();
+}
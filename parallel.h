@@ -0,0 +1,202 @@
+//
+// Created by gosktin on 19.10.26.
+//
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "rational.h"
+
+// A pool of worker threads with a task queue each. A worker takes its own
+// newest task first and, once its queue is empty, steals the oldest task of
+// another worker, so the large tasks that were split first are the ones that
+// migrate. Threads waiting for a TaskGroup run pending tasks meanwhile, which
+// makes nested parallel calls safe.
+class ThreadPool {
+public:
+    // `threads` workers, 0 meaning one per hardware thread.
+    explicit ThreadPool(unsigned threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    static ThreadPool &shared();
+
+    unsigned size() const { return static_cast<unsigned>(queues_.size()); }
+
+    void submit(const std::function<void()> &task);
+
+    // Runs one pending task on the calling thread; false if there was none.
+    bool runPending();
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()> > tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue> > queues_;
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::atomic<size_t> pending_;
+    std::atomic<unsigned> next_;
+    bool stopping_;
+
+    void work(unsigned index);
+    bool take(unsigned index, std::function<void()> &task);
+};
+
+// Tasks submitted together and waited for together.
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool &pool = ThreadPool::shared());
+    ~TaskGroup();
+
+    void run(const std::function<void()> &task);
+    void wait();
+
+private:
+    ThreadPool &pool_;
+    std::atomic<size_t> remaining_;
+    std::mutex mutex_;
+    std::condition_variable done_;
+};
+
+// Rough cost of one operation on a value, used to balance the chunks: long
+// operands take longer, so splitting by element count load-balances badly.
+inline size_t operationCost(const BigInteger &value) {
+    return value.size() + 1;
+}
+
+inline size_t operationCost(const Rational &value) {
+    return value.numerator().size() + value.denominator().size() + 1;
+}
+
+template <typename T>
+size_t operationCost(const T &) {
+    return 1;
+}
+
+// Boundaries of at most `chunks` nonempty ranges of roughly equal cost,
+// from 0 to the number of values; `prefix` holds the running total of the
+// costs, starting with 0.
+std::vector<size_t> splitByCost(const std::vector<size_t> &prefix, size_t chunks);
+
+template <typename T>
+std::vector<size_t> splitByCost(const std::vector<T> &values, ThreadPool &pool) {
+    std::vector<size_t> prefix(values.size() + 1, 0);
+    for (size_t i = 0; i < values.size(); ++i)
+        prefix[i + 1] = prefix[i] + operationCost(values[i]);
+
+    return splitByCost(prefix, 4 * (static_cast<size_t>(pool.size()) + 1));
+}
+
+// Runs `body(begin, end)` for every range and waits for all of them.
+void forEachRange(const std::vector<size_t> &splits, const std::function<void(size_t, size_t)> &body,
+                  ThreadPool &pool);
+
+// output[i] = function(input[i]).
+template <typename In, typename Out, typename Function>
+void parallelTransform(const std::vector<In> &input, std::vector<Out> &output, Function function,
+                       ThreadPool &pool = ThreadPool::shared()) {
+    output.resize(input.size());
+    forEachRange(splitByCost(input, pool), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+            output[i] = function(input[i]);
+    }, pool);
+}
+
+// Folds every chunk in order and then the chunk results in order, so `op`
+// has to be associative but need not be commutative.
+template <typename T, typename Operation>
+T parallelReduce(const std::vector<T> &values, T initial, Operation op, ThreadPool &pool = ThreadPool::shared()) {
+    std::vector<size_t> splits(splitByCost(values, pool));
+    std::vector<T> partial(splits.size() - 1);
+    forEachRange(splits, [&](size_t begin, size_t end) {
+        size_t k = static_cast<size_t>(std::lower_bound(splits.begin(), splits.end(), begin) - splits.begin());
+        T accumulated(values[begin]);
+        for (size_t i = begin + 1; i < end; ++i)
+            accumulated = op(accumulated, values[i]);
+        partial[k] = accumulated;
+    }, pool);
+
+    for (size_t k = 0; k < partial.size(); ++k)
+        initial = op(initial, partial[k]);
+
+    return initial;
+}
+
+template <typename T>
+T parallelSum(const std::vector<T> &values, ThreadPool &pool = ThreadPool::shared()) {
+    return parallelReduce(values, T(0), [](const T &a, const T &b) { return a + b; }, pool);
+}
+
+// Sum of a[i] * b[i] over arrays of equal size.
+template <typename T>
+T parallelDot(const std::vector<T> &a, const std::vector<T> &b, ThreadPool &pool = ThreadPool::shared()) {
+    std::vector<size_t> prefix(a.size() + 1, 0);
+    for (size_t i = 0; i < a.size(); ++i)
+        prefix[i + 1] = prefix[i] + operationCost(a[i]) * operationCost(b[i]);
+    std::vector<size_t> splits(splitByCost(prefix, 4 * (static_cast<size_t>(pool.size()) + 1)));
+
+    std::vector<T> partial(splits.size() - 1, T(0));
+    forEachRange(splits, [&](size_t begin, size_t end) {
+        size_t k = static_cast<size_t>(std::lower_bound(splits.begin(), splits.end(), begin) - splits.begin());
+        T accumulated(0);
+        for (size_t i = begin; i < end; ++i)
+            accumulated += a[i] * b[i];
+        partial[k] = accumulated;
+    }, pool);
+
+    T result(0);
+    for (size_t k = 0; k < partial.size(); ++k)
+        result += partial[k];
+
+    return result;
+}
+
+// Sorts the chunks in parallel, then merges neighbours pairwise, one level
+// of the merge tree at a time.
+template <typename T, typename Compare>
+void parallelSort(std::vector<T> &values, Compare less, ThreadPool &pool = ThreadPool::shared()) {
+    std::vector<size_t> splits(splitByCost(values, pool));
+    forEachRange(splits, [&](size_t begin, size_t end) {
+        std::sort(values.begin() + begin, values.begin() + end, less);
+    }, pool);
+
+    while (splits.size() > 2) {
+        std::vector<size_t> merged;
+        TaskGroup group(pool);
+        for (size_t k = 0; k + 2 < splits.size(); k += 2) {
+            size_t begin = splits[k], middle = splits[k + 1], end = splits[k + 2];
+            group.run([&values, &less, begin, middle, end]() {
+                std::inplace_merge(values.begin() + begin, values.begin() + middle, values.begin() + end, less);
+            });
+            merged.push_back(begin);
+        }
+        if (splits.size() % 2 == 0)
+            merged.push_back(splits[splits.size() - 2]);
+        merged.push_back(splits.back());
+        group.wait();
+        splits.swap(merged);
+    }
+}
+
+template <typename T>
+void parallelSort(std::vector<T> &values, ThreadPool &pool = ThreadPool::shared()) {
+    parallelSort(values, [](const T &a, const T &b) { return a < b; }, pool);
+}
+
+#endif //PARALLEL_H
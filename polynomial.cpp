@@ -0,0 +1,564 @@
+//
+// Created by gosktin on 19.10.26.
+//
+
+#include <algorithm>
+
+#include "parallel.h"
+#include "polynomial.h"
+
+// Products with a shorter operand are cheaper done coefficient by coefficient.
+static const size_t kroneckerTerms = 4;
+
+template <typename T>
+static std::vector<T> multiplyBasecase(const std::vector<T> &a, const std::vector<T> &b) {
+    std::vector<T> result(a.size() + b.size() - 1, T(0));
+    for (size_t i = 0; i < a.size(); ++i)
+        for (size_t j = 0; j < b.size(); ++j)
+            result[i + j] += a[i] * b[j];
+
+    return result;
+}
+
+// The numerators over the least common denominator, which is returned.
+static BigInteger clearDenominators(const std::vector<Rational> &values, std::vector<BigInteger> &numerators) {
+    std::vector<std::pair<BigInteger, BigInteger> > parts(values.size());
+    BigInteger multiple(1);
+    for (size_t i = 0; i < values.size(); ++i) {
+        parts[i] = values[i].p();
+        if (parts[i].second != multiple)
+            multiple = multiple / gcd(multiple, parts[i].second) * parts[i].second;
+    }
+
+    numerators.resize(values.size());
+    for (size_t i = 0; i < values.size(); ++i)
+        numerators[i] = parts[i].second == multiple ? parts[i].first : parts[i].first * (multiple / parts[i].second);
+
+    return multiple;
+}
+
+template <typename T>
+Polynomial<T>::Polynomial() {}
+
+template <typename T>
+Polynomial<T>::Polynomial(const T &constant) : coefficients_(1, constant) {
+    trim();
+}
+
+template <typename T>
+Polynomial<T>::Polynomial(const std::vector<T> &coefficients) : coefficients_(coefficients) {
+    trim();
+}
+
+template <typename T>
+Polynomial<T> Polynomial<T>::linear(const T &root) {
+    std::vector<T> coefficients(2, T(1));
+    coefficients[0] = -root;
+
+    return Polynomial(coefficients);
+}
+
+template <typename T>
+void Polynomial<T>::trim() {
+    while (!coefficients_.empty() && coefficients_.back() == T(0))
+        coefficients_.pop_back();
+}
+
+template <typename T>
+T Polynomial<T>::coefficient(size_t power) const {
+    return power < coefficients_.size() ? coefficients_[power] : T(0);
+}
+
+template <typename T>
+T Polynomial<T>::leading() const {
+    return coefficients_.empty() ? T(0) : coefficients_.back();
+}
+
+static BigInteger evaluateAt(const std::vector<BigInteger> &coefficients, const BigInteger &x) {
+    BigInteger result(0);
+    for (size_t i = coefficients.size(); i > 0; --i) {
+        result *= x;
+        result += coefficients[i - 1];
+    }
+
+    return result;
+}
+
+// Horner's rule on the numerators in homogeneous form, sum of N_i a^i b^(d-i)
+// for x = a / b, leaves a single fraction to reduce instead of one per step.
+static Rational evaluateAt(const std::vector<Rational> &coefficients, const Rational &x) {
+    if (coefficients.empty())
+        return Rational(0);
+
+    std::vector<BigInteger> numerators;
+    BigInteger denominator(clearDenominators(coefficients, numerators));
+    BigInteger result(numerators.back()), scale(1);
+    for (size_t i = numerators.size() - 1; i > 0; --i) {
+        scale *= x.denominator();
+        result *= x.numerator();
+        result += numerators[i - 1] * scale;
+    }
+
+    return Rational(result, denominator * scale);
+}
+
+template <typename T>
+T Polynomial<T>::evaluate(const T &x) const {
+    return evaluateAt(coefficients_, x);
+}
+
+// Over exact coefficients a remainder tree does not pay: its nodes grow with
+// the number of points, and the remainders cost more than Horner's rule on
+// small points. The points are independent, so they go to the pool instead.
+template <typename T>
+std::vector<T> Polynomial<T>::evaluate(const std::vector<T> &points) const {
+    std::vector<T> values;
+    parallelTransform(points, values, [this](const T &x) { return evaluate(x); });
+
+    return values;
+}
+
+template <typename T>
+Polynomial<T> Polynomial<T>::derivative() const {
+    std::vector<T> coefficients;
+    for (size_t i = 1; i < coefficients_.size(); ++i)
+        coefficients.push_back(coefficients_[i] * T(static_cast<int>(i)));
+
+    return Polynomial(coefficients);
+}
+
+template <typename T>
+Polynomial<T> Polynomial<T>::operator-() const {
+    Polynomial result(*this);
+    for (size_t i = 0; i < result.coefficients_.size(); ++i)
+        result.coefficients_[i] = -result.coefficients_[i];
+
+    return result;
+}
+
+template <typename T>
+Polynomial<T> &Polynomial<T>::operator+=(const Polynomial &right) {
+    if (coefficients_.size() < right.coefficients_.size())
+        coefficients_.resize(right.coefficients_.size(), T(0));
+    for (size_t i = 0; i < right.coefficients_.size(); ++i)
+        coefficients_[i] += right.coefficients_[i];
+    trim();
+
+    return *this;
+}
+
+template <typename T>
+Polynomial<T> &Polynomial<T>::operator-=(const Polynomial &right) {
+    if (coefficients_.size() < right.coefficients_.size())
+        coefficients_.resize(right.coefficients_.size(), T(0));
+    for (size_t i = 0; i < right.coefficients_.size(); ++i)
+        coefficients_[i] -= right.coefficients_[i];
+    trim();
+
+    return *this;
+}
+
+// Coefficients below 10^w / 2 in absolute value, evaluated at 10^w, split
+// into w-digit slots that are read back as balanced digits. The positive and
+// negative coefficients are laid out separately, so packing is copying
+// digits, and one subtraction joins them.
+template <typename T>
+BigInteger Polynomial<T>::pack(const std::vector<BigInteger> &coefficients, size_t width, bool negative) {
+    DigitVector digits(coefficients.size() * width, 0);
+    for (size_t i = 0; i < coefficients.size(); ++i)
+        if (coefficients[i] && coefficients[i].isNegative() == negative)
+            std::copy(coefficients[i].number_.begin(), coefficients[i].number_.end(), digits.begin() + i * width);
+
+    return BigInteger(digits.data(), digits.size(), true);
+}
+
+template <typename T>
+std::vector<BigInteger> Polynomial<T>::unpack(const BigInteger &value, size_t width, size_t count) {
+    const DigitVector &digits = value.number_;
+    BigInteger base(power(BigInteger(10), width));
+
+    std::vector<BigInteger> coefficients(count);
+    bool carry = false;
+    for (size_t i = 0; i < count; ++i) {
+        size_t begin = i * width;
+        BigInteger slot(0);
+        if (begin < digits.size())
+            slot = BigInteger(digits.data() + begin, std::min(width, digits.size() - begin), true);
+        if (carry)
+            ++slot;
+        carry = slot * 2 >= base;
+        if (carry)
+            slot -= base;
+        coefficients[i] = value.isNegative() ? -slot : slot;
+    }
+
+    return coefficients;
+}
+
+// A product coefficient is a sum of at most min(n, m) products, so the slot
+// width covers both operands' digits, the digits of that count and one more
+// for the balanced range.
+template <typename T>
+std::vector<BigInteger> Polynomial<T>::kronecker(const std::vector<BigInteger> &a, const std::vector<BigInteger> &b) {
+    size_t longestA = 1, longestB = 1, terms = std::min(a.size(), b.size());
+    bool negative = false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        longestA = max(longestA, a[i].size());
+        negative = negative || a[i].isNegative();
+    }
+    for (size_t i = 0; i < b.size(); ++i) {
+        longestB = max(longestB, b[i].size());
+        negative = negative || b[i].isNegative();
+    }
+    size_t width = longestA + longestB + BigInteger(static_cast<int>(terms)).size() + 1;
+
+    BigInteger x(pack(a, width, false)), y(pack(b, width, false));
+    if (negative) {
+        x -= pack(a, width, true);
+        y -= pack(b, width, true);
+    }
+
+    return unpack(x * y, width, a.size() + b.size() - 1);
+}
+
+template <typename T>
+std::vector<BigInteger> Polynomial<T>::multiplyCoefficients(const std::vector<BigInteger> &a,
+                                                            const std::vector<BigInteger> &b) {
+    if (std::min(a.size(), b.size()) < kroneckerTerms)
+        return multiplyBasecase(a, b);
+
+    return kronecker(a, b);
+}
+
+// Over the common denominators the numerators multiply as integers.
+template <typename T>
+std::vector<Rational> Polynomial<T>::multiplyCoefficients(const std::vector<Rational> &a,
+                                                          const std::vector<Rational> &b) {
+    if (std::min(a.size(), b.size()) < kroneckerTerms)
+        return multiplyBasecase(a, b);
+
+    std::vector<BigInteger> x, y;
+    BigInteger denominator(clearDenominators(a, x) * clearDenominators(b, y));
+    std::vector<BigInteger> product(Polynomial<BigInteger>::multiplyCoefficients(x, y));
+
+    std::vector<Rational> result(product.size());
+    for (size_t i = 0; i < product.size(); ++i)
+        result[i] = Rational(product[i], denominator);
+
+    return result;
+}
+
+template <typename T>
+Polynomial<T> &Polynomial<T>::operator*=(const Polynomial &right) {
+    if (isZero() || right.isZero()) {
+        coefficients_.clear();
+        return *this;
+    }
+
+    coefficients_ = multiplyCoefficients(coefficients_, right.coefficients_);
+    trim();
+
+    return *this;
+}
+
+template <typename T>
+Polynomial<T> &Polynomial<T>::operator*=(const T &factor) {
+    for (size_t i = 0; i < coefficients_.size(); ++i)
+        coefficients_[i] *= factor;
+    trim();
+
+    return *this;
+}
+
+template <typename T>
+Polynomial<T> &Polynomial<T>::operator/=(const T &divisor) {
+    for (size_t i = 0; i < coefficients_.size(); ++i)
+        coefficients_[i] /= divisor;
+    trim();
+
+    return *this;
+}
+
+template <typename T>
+Polynomial<T> Polynomial<T>::operator+(const Polynomial &right) const {
+    Polynomial temp(*this);
+
+    return temp += right;
+}
+
+template <typename T>
+Polynomial<T> Polynomial<T>::operator-(const Polynomial &right) const {
+    Polynomial temp(*this);
+
+    return temp -= right;
+}
+
+template <typename T>
+Polynomial<T> Polynomial<T>::operator*(const Polynomial &right) const {
+    Polynomial temp(*this);
+
+    return temp *= right;
+}
+
+template <typename T>
+bool Polynomial<T>::operator==(const Polynomial &right) const {
+    return coefficients_ == right.coefficients_;
+}
+
+template <typename T>
+bool Polynomial<T>::operator!=(const Polynomial &right) const {
+    return !(*this == right);
+}
+
+// Long division, with the divisions skipped for a monic b.
+static void divideOf(const Polynomial<BigInteger> &a, const Polynomial<BigInteger> &b,
+                     Polynomial<BigInteger> &quotient, Polynomial<BigInteger> &remainder) {
+    size_t n = a.coefficients().size(), m = b.coefficients().size() - 1;
+    const std::vector<BigInteger> &divisor = b.coefficients();
+    std::vector<BigInteger> r(a.coefficients()), q(n - m, BigInteger(0));
+
+    BigInteger lead(b.leading());
+    bool monic = lead == BigInteger(1);
+    for (size_t k = n - m; k > 0; --k) {
+        BigInteger &top = r[k - 1 + m];
+        if (!top)
+            continue;
+        BigInteger c(monic ? top : top / lead);
+        for (size_t j = 0; j <= m; ++j)
+            r[k - 1 + j] -= c * divisor[j];
+        q[k - 1] = c;
+    }
+    r.resize(m);
+
+    quotient = Polynomial<BigInteger>(q);
+    remainder = Polynomial<BigInteger>(r);
+}
+
+// lc(b)^e a = q b + r with e = deg a - deg b + 1, all in integers.
+static void pseudoDivide(const std::vector<BigInteger> &a, const std::vector<BigInteger> &b,
+                         std::vector<BigInteger> &q, std::vector<BigInteger> &r) {
+    size_t n = a.size(), m = b.size() - 1;
+    const BigInteger &lead = b.back();
+    r = a;
+    q.assign(n - m, BigInteger(0));
+    for (size_t k = n - m; k > 0; --k) {
+        BigInteger c(r[k - 1 + m]);
+        for (size_t i = k; i < q.size(); ++i)
+            q[i] *= lead;
+        for (size_t i = 0; i + 1 < k + m; ++i)
+            r[i] *= lead;
+        if (c)
+            for (size_t j = 0; j < m; ++j)
+                r[k - 1 + j] -= c * b[j];
+        q[k - 1] = c;
+    }
+    r.resize(m);
+}
+
+// Field division steps would reduce a fraction per coefficient and step.
+// With a = A / alpha and b = B / beta for integral A and B, pseudo-division
+// lc(B)^e A = Q B + R gives a = (beta Q / s) b + R / s for s = alpha lc(B)^e,
+// so only the results are reduced.
+static void divideOf(const Polynomial<Rational> &a, const Polynomial<Rational> &b,
+                     Polynomial<Rational> &quotient, Polynomial<Rational> &remainder) {
+    std::vector<BigInteger> x, y, q, r;
+    BigInteger alpha(clearDenominators(a.coefficients(), x)), beta(clearDenominators(b.coefficients(), y));
+    pseudoDivide(x, y, q, r);
+
+    BigInteger scale(alpha * power(y.back(), q.size()));
+    std::vector<Rational> coefficients(q.size());
+    for (size_t i = 0; i < q.size(); ++i)
+        coefficients[i] = Rational(q[i] * beta, scale);
+    quotient = Polynomial<Rational>(coefficients);
+
+    coefficients.resize(r.size());
+    for (size_t i = 0; i < r.size(); ++i)
+        coefficients[i] = Rational(r[i], scale);
+    remainder = Polynomial<Rational>(coefficients);
+}
+
+template <typename T>
+void Polynomial<T>::divmod(const Polynomial &a, const Polynomial &b, Polynomial &quotient, Polynomial &remainder) {
+    if (b.isZero() || a.degree() < b.degree()) {
+        remainder = a;
+        quotient = Polynomial();
+        return;
+    }
+
+    divideOf(a, b, quotient, remainder);
+}
+
+template <typename T>
+Polynomial<T> Polynomial<T>::pseudoRemainder(const Polynomial &a, const Polynomial &b) {
+    long m = b.degree();
+    if (m < 0 || a.degree() < m)
+        return a;
+
+    T lead(b.leading());
+    long steps = a.degree() - m + 1;
+    Polynomial r(a);
+    while (!r.isZero() && r.degree() >= m) {
+        T c(r.leading());
+        size_t shift = static_cast<size_t>(r.degree() - m);
+        for (size_t i = 0; i < r.coefficients_.size(); ++i)
+            r.coefficients_[i] *= lead;
+        for (long j = 0; j <= m; ++j)
+            r.coefficients_[shift + static_cast<size_t>(j)] -= c * b.coefficients_[static_cast<size_t>(j)];
+        r.trim();
+        --steps;
+    }
+    for (; steps > 0; --steps)
+        r *= lead;
+
+    return r;
+}
+
+static BigInteger content(const Polynomial<BigInteger> &p) {
+    BigInteger result(0);
+    for (size_t i = 0; i < p.coefficients().size() && result != BigInteger(1); ++i)
+        result = gcd(result, p.coefficients()[i]);
+
+    return result;
+}
+
+// The subresultant remainder sequence divides every pseudo-remainder by
+// g * h^delta, which keeps the coefficients as small as the subresultants.
+static Polynomial<BigInteger> gcdOf(Polynomial<BigInteger> a, Polynomial<BigInteger> b) {
+    if (a.degree() < b.degree())
+        std::swap(a, b);
+    if (b.isZero()) {
+        if (!a.isZero() && a.leading().isNegative())
+            a = -a;
+        return a;
+    }
+
+    BigInteger common(gcd(content(a), content(b)));
+    a /= content(a);
+    b /= content(b);
+
+    BigInteger g(1), h(1);
+    while (true) {
+        size_t delta = static_cast<size_t>(a.degree() - b.degree());
+        Polynomial<BigInteger> r(Polynomial<BigInteger>::pseudoRemainder(a, b));
+        if (r.isZero())
+            break;
+        if (r.degree() == 0) {
+            b = Polynomial<BigInteger>(BigInteger(1));
+            break;
+        }
+
+        a = b;
+        r /= g * power(h, delta);
+        b = r;
+        g = a.leading();
+        if (delta == 1)
+            h = g;
+        else if (delta > 1)
+            h = power(g, delta) / power(h, delta - 1);
+    }
+
+    b /= content(b);
+    if (b.leading().isNegative())
+        b = -b;
+
+    return b *= common;
+}
+
+// Over the rationals the gcd is that of the integer primitive parts, made
+// monic at the end.
+static Polynomial<Rational> gcdOf(const Polynomial<Rational> &a, const Polynomial<Rational> &b) {
+    std::vector<BigInteger> x, y;
+    clearDenominators(a.coefficients(), x);
+    clearDenominators(b.coefficients(), y);
+    Polynomial<BigInteger> integral(gcdOf(Polynomial<BigInteger>(x), Polynomial<BigInteger>(y)));
+    if (integral.isZero())
+        return Polynomial<Rational>();
+
+    std::vector<Rational> coefficients(integral.coefficients().size());
+    for (size_t i = 0; i < coefficients.size(); ++i)
+        coefficients[i] = Rational(integral.coefficients()[i], integral.leading());
+
+    return Polynomial<Rational>(coefficients);
+}
+
+template <typename T>
+Polynomial<T> Polynomial<T>::gcd(const Polynomial &a, const Polynomial &b) {
+    return gcdOf(a, b);
+}
+
+// With x_i = a_i / b_i and L_i = b_i x - a_i the Lagrange form reads
+// sum of y_i b_i^(n-1) / D_i * product of L_j over j != i, where D_i is the
+// product of b_j a_i - a_j b_i over j != i. The sums go up the subproduct
+// tree of the L_i as in PrimeBasis, a node's sum being left * product(right)
+// + right * product(left), each kept as an integer polynomial over one
+// denominator.
+Polynomial<Rational> interpolate(const std::vector<Rational> &points, const std::vector<Rational> &values) {
+    size_t n = points.size();
+    if (n == 0)
+        return Polynomial<Rational>();
+
+    std::vector<std::pair<BigInteger, BigInteger> > x(n);
+    std::vector<std::vector<Polynomial<BigInteger> > > levels(1);
+    for (size_t i = 0; i < n; ++i) {
+        x[i] = points[i].p();
+        std::vector<BigInteger> factor(1, -x[i].first);
+        factor.push_back(x[i].second);
+        levels[0].push_back(Polynomial<BigInteger>(factor));
+    }
+    while (levels.back().size() > 1) {
+        const std::vector<Polynomial<BigInteger> > &below = levels.back();
+        std::vector<Polynomial<BigInteger> > level;
+        for (size_t i = 0; i + 1 < below.size(); i += 2)
+            level.push_back(below[i] * below[i + 1]);
+        if (below.size() % 2)
+            level.push_back(below.back());
+        levels.push_back(level);
+    }
+
+    std::vector<size_t> indices(n);
+    for (size_t i = 0; i < n; ++i)
+        indices[i] = i;
+    std::vector<Rational> weights;
+    parallelTransform(indices, weights, [&](size_t i) {
+        BigInteger d(1);
+        for (size_t j = 0; j < n; ++j)
+            if (j != i)
+                d *= x[j].second * x[i].first - x[j].first * x[i].second;
+        return Rational(values[i].numerator() * power(x[i].second, n - 1), values[i].denominator() * d);
+    });
+
+    std::vector<Polynomial<BigInteger> > sums(n);
+    std::vector<BigInteger> denominators(n);
+    for (size_t i = 0; i < n; ++i) {
+        std::pair<BigInteger, BigInteger> w(weights[i].p());
+        sums[i] = Polynomial<BigInteger>(w.first);
+        denominators[i] = w.second;
+    }
+    for (size_t h = 0; h + 1 < levels.size(); ++h) {
+        std::vector<Polynomial<BigInteger> > above;
+        std::vector<BigInteger> aboveDenominators;
+        for (size_t i = 0; i + 1 < sums.size(); i += 2) {
+            BigInteger common(gcd(denominators[i], denominators[i + 1]));
+            Polynomial<BigInteger> left(sums[i] * levels[h][i + 1]), right(sums[i + 1] * levels[h][i]);
+            left *= denominators[i + 1] / common;
+            right *= denominators[i] / common;
+            above.push_back(left + right);
+            aboveDenominators.push_back(denominators[i] / common * denominators[i + 1]);
+        }
+        if (sums.size() % 2) {
+            above.push_back(sums.back());
+            aboveDenominators.push_back(denominators.back());
+        }
+        sums.swap(above);
+        denominators.swap(aboveDenominators);
+    }
+
+    std::vector<Rational> coefficients(sums[0].coefficients().size());
+    for (size_t i = 0; i < coefficients.size(); ++i)
+        coefficients[i] = Rational(sums[0].coefficients()[i], denominators[0]);
+
+    return Polynomial<Rational>(coefficients);
+}
+
+template class Polynomial<BigInteger>;
+template class Polynomial<Rational>;
@@ -0,0 +1,94 @@
+//
+// Created by gosktin on 19.10.26.
+//
+
+#ifndef POLYNOMIAL_H
+#define POLYNOMIAL_H
+
+#include <cstddef>
+#include <vector>
+
+#include "rational.h"
+
+// Dense univariate polynomial with coefficients from the lowest power up and
+// no zero leading coefficient, so the zero polynomial has none at all.
+// Instantiated for BigInteger and Rational.
+//
+// Products go through Kronecker substitution: both operands are evaluated at
+// a power of ten wide enough to keep the coefficients apart, multiplied as
+// two integers and split again, so polynomial multiplication runs at the
+// speed of BigInteger multiplication.
+template <typename T>
+class Polynomial {
+public:
+    Polynomial();
+    Polynomial(const T &constant);
+    explicit Polynomial(const std::vector<T> &coefficients);
+
+    // x - root.
+    static Polynomial linear(const T &root);
+
+    // -1 for the zero polynomial.
+    long degree() const { return static_cast<long>(coefficients_.size()) - 1; }
+    bool isZero() const { return coefficients_.empty(); }
+
+    const std::vector<T> &coefficients() const { return coefficients_; }
+    T coefficient(size_t power) const;
+    T leading() const;
+
+    T evaluate(const T &x) const;
+    // Values at all the points, split over the shared thread pool.
+    std::vector<T> evaluate(const std::vector<T> &points) const;
+
+    Polynomial derivative() const;
+
+    Polynomial operator-() const;
+    Polynomial &operator+=(const Polynomial &right);
+    Polynomial &operator-=(const Polynomial &right);
+    Polynomial &operator*=(const Polynomial &right);
+    Polynomial &operator*=(const T &factor);
+    // Divides every coefficient; over BigInteger the division must be exact.
+    Polynomial &operator/=(const T &divisor);
+
+    Polynomial operator+(const Polynomial &right) const;
+    Polynomial operator-(const Polynomial &right) const;
+    Polynomial operator*(const Polynomial &right) const;
+
+    bool operator==(const Polynomial &right) const;
+    bool operator!=(const Polynomial &right) const;
+
+    // a = quotient * b + remainder with deg remainder < deg b. Over
+    // BigInteger every leading coefficient met must be divisible by that of
+    // b, which always holds for a monic b.
+    static void divmod(const Polynomial &a, const Polynomial &b, Polynomial &quotient, Polynomial &remainder);
+    // lc(b)^(deg a - deg b + 1) * a mod b, which needs no division.
+    static Polynomial pseudoRemainder(const Polynomial &a, const Polynomial &b);
+
+    // Over BigInteger the gcd with positive leading coefficient and the
+    // content included, over Rational the monic one; both from the
+    // subresultant remainder sequence, so no coefficient blows up.
+    static Polynomial gcd(const Polynomial &a, const Polynomial &b);
+
+private:
+    template <typename U> friend class Polynomial;
+
+    std::vector<T> coefficients_;
+
+    void trim();
+
+    static BigInteger pack(const std::vector<BigInteger> &coefficients, size_t width, bool negative);
+    static std::vector<BigInteger> unpack(const BigInteger &value, size_t width, size_t count);
+    static std::vector<BigInteger> kronecker(const std::vector<BigInteger> &a, const std::vector<BigInteger> &b);
+
+    static std::vector<BigInteger> multiplyCoefficients(const std::vector<BigInteger> &a,
+                                                        const std::vector<BigInteger> &b);
+    static std::vector<Rational> multiplyCoefficients(const std::vector<Rational> &a, const std::vector<Rational> &b);
+};
+
+// The polynomial of degree below points.size() through all (points[i],
+// values[i]); the points must be distinct. The Lagrange basis is built up a
+// subproduct tree of integer linear factors, so the work is a few integer
+// polynomial products per level and a gcd per node.
+Polynomial<Rational> interpolate(const std::vector<Rational> &points, const std::vector<Rational> &values);
+
+#endif //POLYNOMIAL_H
@@ -0,0 +1,183 @@
+//
+// Created by gosktin on 19.10.26.
+//
+
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstddef>
+
+#include "array.h"
+#include "rational.h"
+
+// Uniform decimal digits from any uniform random bit generator, written
+// straight into digit storage. Every 64 bits drawn give 18 digits, and the
+// bits are taken from the generator by a fixed rule rather than through
+// std::uniform_int_distribution, so a seeded standard engine yields the same
+// numbers on every platform.
+//
+// One source should serve a whole batch: it keeps the unused digits of the
+// last word for the next value.
+template <typename URBG>
+class RandomDigits {
+public:
+    explicit RandomDigits(URBG &rng) : rng_(rng), word_(0), left_(0) {}
+
+    int next();
+
+    // Uniform in [0, 10^count).
+    BigInteger digits(size_t count);
+    // Uniform in [0, |bound|); `bound` must not be zero.
+    BigInteger below(const BigInteger &bound);
+    // Appends `count` values uniform in [0, |bound|) to `out`, each written
+    // in place at the end of its digit pool.
+    void below(const BigInteger &bound, size_t count, BigIntegerArray &out);
+
+private:
+    URBG &rng_;
+    unsigned long long word_;
+    unsigned left_;
+
+    // Uniform in [0, 2^64).
+    unsigned long long nextWord();
+    // Rejection sampling from the leading digit down: a draw above the digit
+    // of `bound` at its position starts over at once, one below it leaves
+    // the rest free, so a rejected attempt rarely costs more than a digit.
+    void fillBelow(const int *bound, size_t m, int *out);
+};
+
+template <typename URBG>
+int RandomDigits<URBG>::next() {
+    const unsigned long long block = 1000000000000000000ULL;
+    if (left_ == 0) {
+        do
+            word_ = nextWord();
+        while (word_ >= 18 * block);
+        word_ %= block;
+        left_ = 18;
+    }
+    --left_;
+    int digit = static_cast<int>(word_ % 10);
+    word_ /= 10;
+
+    return digit;
+}
+
+template <typename URBG>
+BigInteger RandomDigits<URBG>::digits(size_t count) {
+    BigInteger result;
+    result.number_.resize(count > 0 ? count : 1, 0);
+    int *digits = result.number_.data();
+    for (size_t i = 0; i < count; ++i)
+        digits[i] = next();
+    result.canonify();
+
+    return result;
+}
+
+template <typename URBG>
+BigInteger RandomDigits<URBG>::below(const BigInteger &bound) {
+    BigInteger result;
+    size_t m = bound.size();
+    result.number_.resize(m);
+    fillBelow(bound.number_.data(), m, result.number_.data());
+    result.canonify();
+
+    return result;
+}
+
+template <typename URBG>
+void RandomDigits<URBG>::below(const BigInteger &bound, size_t count, BigIntegerArray &out) {
+    size_t m = bound.size();
+    out.reserve(out.size() + count, out.digits() + count * m);
+    for (size_t k = 0; k < count; ++k) {
+        size_t start = out.pool_.size();
+        out.pool_.resize(start + m);
+        fillBelow(bound.number_.data(), m, out.pool_.data() + start);
+
+        size_t end = start + m;
+        while (end > start + 1 && out.pool_[end - 1] == 0)
+            --end;
+        out.pool_.resize(end);
+        out.offsets_.push_back(end);
+        out.negative_.push_back(false);
+    }
+}
+
+template <typename URBG>
+unsigned long long RandomDigits<URBG>::nextWord() {
+    const unsigned long long range = static_cast<unsigned long long>(URBG::max() - URBG::min());
+    // The widest run of bits the generator gives uniformly in one call.
+    unsigned bits = 64;
+    while (bits > 1 && range < (~0ULL >> (64 - bits)))
+        --bits;
+    const unsigned long long mask = ~0ULL >> (64 - bits);
+
+    unsigned long long word = 0;
+    for (unsigned filled = 0; filled < 64; filled += bits) {
+        unsigned long long value;
+        do
+            value = static_cast<unsigned long long>(rng_() - URBG::min());
+        while (value > mask);
+        word = bits == 64 ? value : (word << bits) | value;
+    }
+
+    return word;
+}
+
+template <typename URBG>
+void RandomDigits<URBG>::fillBelow(const int *bound, size_t m, int *out) {
+    for (;;) {
+        bool below = false;
+        size_t i = m;
+        while (i-- > 0) {
+            int digit = next();
+            if (!below) {
+                if (digit > bound[i])
+                    break;
+                below = digit < bound[i];
+            }
+            out[i] = digit;
+        }
+        if (i == static_cast<size_t>(-1) && below)
+            return;
+    }
+}
+
+// Single values, each from a source of its own. Batches should share one
+// RandomDigits instead, or use the bulk overload of randomBelow.
+
+// Uniform in [0, 10^count) and in [0, 2^bits).
+template <typename URBG>
+BigInteger randomDigits(size_t count, URBG &rng) {
+    return RandomDigits<URBG>(rng).digits(count);
+}
+
+template <typename URBG>
+BigInteger randomBits(size_t bits, URBG &rng) {
+    return RandomDigits<URBG>(rng).below(power(2, bits));
+}
+
+// Uniform in [0, |bound|); `bound` must not be zero.
+template <typename URBG>
+BigInteger randomBelow(const BigInteger &bound, URBG &rng) {
+    return RandomDigits<URBG>(rng).below(bound);
+}
+
+// `count` values uniform in [0, |bound|), generated into one digit pool.
+template <typename URBG>
+BigIntegerArray randomBelow(const BigInteger &bound, size_t count, URBG &rng) {
+    BigIntegerArray values;
+    RandomDigits<URBG>(rng).below(bound, count, values);
+
+    return values;
+}
+
+// low + (high - low) k / steps for k uniform in [0, steps): evenly spread
+// over [low, high) at the resolution `steps`, which must be positive.
+template <typename URBG>
+Rational randomRational(const Rational &low, const Rational &high, const BigInteger &steps, URBG &rng) {
+    return low + (high - low) * Rational(randomBelow(steps, rng), steps);
+}
+
+#endif //RANDOM_H
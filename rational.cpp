@@ -0,0 +1,704 @@
+//
+// Created by gosktin on 19.10.26.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include "execution.h"
+#include "rational.h"
+
+ContinuedFraction::ContinuedFraction(const BigInteger &numerator, const BigInteger &denominator) :
+        numerator_(numerator), denominator_(denominator) {}
+
+bool ContinuedFraction::next(BigInteger &quotient) {
+    if (!denominator_)
+        return false;
+
+    BigInteger remainder;
+    BigInteger::divmod(numerator_, denominator_, quotient, remainder);
+    if (remainder.isNegative()) {
+        --quotient;
+        remainder += denominator_;
+    }
+    numerator_ = denominator_;
+    denominator_ = remainder;
+
+    return true;
+}
+
+BigInteger Rational::gcd(const BigInteger &a, const BigInteger &b) const {
+    NUMERICAL_NESTED_OPERATION(OperationRationalGcd, max(a.size(), b.size()));
+
+    return ::gcd(a, b);
+}
+
+Rational::Rational() {
+    numerator_ = 0;
+    denominator_ = 1;
+}
+
+Rational::Rational(int old) {
+    numerator_ = old;
+    denominator_ = 1;
+}
+
+Rational::Rational(long value) : Rational(static_cast<long long>(value)) {}
+
+Rational::Rational(long long value) : numerator_(BigInteger(std::to_string(value))), denominator_(1) {}
+
+Rational::Rational(unsigned value) : Rational(static_cast<unsigned long long>(value)) {}
+
+Rational::Rational(unsigned long value) : Rational(static_cast<unsigned long long>(value)) {}
+
+Rational::Rational(unsigned long long value) : numerator_(BigInteger(std::to_string(value))), denominator_(1) {}
+
+Rational::Rational(BigInteger big) {
+    numerator_ = big;
+    denominator_ = 1;
+}
+
+Rational::Rational(BigInteger numerator, BigInteger denominator) {
+    BigInteger g(gcd(numerator, denominator));
+    numerator_ = numerator / g;
+    denominator_ = denominator / g;
+
+    if (denominator_ < 0) {
+        denominator_ = -denominator_;
+        numerator_ = -numerator_;
+    }
+}
+
+Rational::Rational(double value) : numerator_(0), denominator_(1) {
+    // Both zeros, which frexp gives no exponent to strip.
+    if (value == 0)
+        return;
+
+    int exponent;
+    double mantissa = std::frexp(value, &exponent);
+    long long bits = static_cast<long long>(std::ldexp(mantissa, 53));
+    exponent -= 53;
+    while (bits != 0 && bits % 2 == 0 && exponent < 0) {
+        bits /= 2;
+        ++exponent;
+    }
+
+    numerator_ = BigInteger(std::to_string(bits));
+    denominator_ = 1;
+    if (exponent > 0)
+        numerator_ *= power(2, static_cast<size_t>(exponent));
+    else
+        denominator_ = power(2, static_cast<size_t>(-exponent));
+}
+
+Rational::~Rational() {}
+
+Rational Rational::operator-() const {
+    Rational temp(*this);
+    temp.numerator_ = -temp.numerator_;
+    return temp;
+}
+
+// |value| for at most 19 digits, read off the digits.
+static unsigned long long toWord(const BigInteger &value) {
+    const DigitVector &digits = value.raw();
+    unsigned long long word = 0;
+    for (size_t i = digits.size(); i-- > 0;)
+        word = word * 10 + static_cast<unsigned long long>(digits[i]);
+
+    return word;
+}
+
+static int bitLength(unsigned long long word) {
+    int length = 0;
+    for (; word; word >>= 1)
+        ++length;
+
+    return length;
+}
+
+// value *= 2^count through a table of 2^30j, built once, and a factor below
+// 2^30, which the basecase applies in a single pass.
+static void scaleByTwo(BigInteger &value, size_t count) {
+    static const std::vector<BigInteger> table = [] {
+        std::vector<BigInteger> powers(1, BigInteger(1));
+        while (powers.size() < 37)
+            powers.push_back(powers.back() * (1 << 30));
+        return powers;
+    }();
+
+    if (count >= 30)
+        BigInteger::multiply(value, value, table[count / 30]);
+    if (count % 30)
+        BigInteger::multiply(value, value, BigInteger(1 << (count % 30)));
+}
+
+// The quotient q, with remainder r, of a value scaled by 2^shift, rounded to
+// 53 bits: the bits of q beyond them are dropped, r only breaking ties.
+static double roundQuotient(unsigned long long q, bool remainder, int compareHalf, int shift) {
+    int extra = std::max(bitLength(q) - 53, 0);
+    unsigned long long dropped = q & ((1ULL << extra) - 1), half = extra ? 1ULL << (extra - 1) : 0;
+    q >>= extra;
+
+    bool up;
+    if (extra == 0)
+        up = compareHalf > 0 || (compareHalf == 0 && q % 2 == 1);
+    else
+        up = dropped > half || (dropped == half && (remainder || q % 2 == 1));
+
+    return std::ldexp(static_cast<double>(q + up), extra - shift);
+}
+
+// Correctly rounded numerator / denominator of positive operands. The
+// quotient is scaled by a power of two to 53 bits and one to spare, fewer
+// for subnormals, and the bits below 53 and the remainder decide the
+// rounding. Operands of up to 19 digits are divided in a machine word.
+double Rational::quotient(const BigInteger &numerator, const BigInteger &denominator) {
+#ifdef __SIZEOF_INT128__
+    if (numerator.size() <= 19 && denominator.size() <= 19) {
+        unsigned long long n = toWord(numerator), d = toWord(denominator);
+        // n 2^shift / d lies in [2^52, 2^54), with n 2^shift below 2^117.
+        int shift = 53 + bitLength(d) - bitLength(n);
+        unsigned __int128 a = n, b = d;
+        if (shift > 0)
+            a <<= shift;
+        else
+            b <<= -shift;
+        unsigned __int128 r = a % b;
+        int compareHalf = 2 * r < b ? -1 : 2 * r > b;
+
+        return roundQuotient(static_cast<unsigned long long>(a / b), r != 0, compareHalf, shift);
+    }
+#endif
+
+    const unsigned long long low = 1ULL << 52;
+    const double log2of10 = 3.321928094887362;
+
+    int exponent = static_cast<int>(std::floor((magnitude(numerator) - magnitude(denominator)) * log2of10));
+    if (exponent > 1024)
+        return HUGE_VAL;
+    if (exponent < -1080)
+        return 0;
+
+    BigInteger n, d, q, r;
+    while (true) {
+        int shift = std::min(53 - exponent, 1074);
+        n = numerator;
+        d = denominator;
+        if (shift > 0)
+            scaleByTwo(n, static_cast<size_t>(shift));
+        else
+            scaleByTwo(d, static_cast<size_t>(-shift));
+
+        BigInteger::divmod(n, d, q, r);
+        if (q.size() > 19) {
+            ++exponent;
+            continue;
+        }
+        unsigned long long bits = toWord(q);
+        if (bits < low && shift < 1074) {
+            --exponent;
+            continue;
+        }
+
+        BigInteger::add(r, r, r);
+        int compareHalf = r < d ? -1 : r > d;
+
+        return roundQuotient(bits, static_cast<bool>(r), compareHalf, shift);
+    }
+}
+
+double Rational::magnitude(const BigInteger &big) {
+    return fraction(big) + static_cast<double>(big.size());
+}
+
+// log10 |big| minus its digit count, in [-1, 0).
+double Rational::fraction(const BigInteger &big) {
+    const DigitVector &digits = big.raw();
+    size_t leading = std::min(digits.size(), static_cast<size_t>(17));
+    double lead = 0;
+    for (size_t i = 1; i <= leading; ++i)
+        lead = lead * 10 + digits[digits.size() - i];
+
+    return std::log10(lead) - static_cast<double>(leading);
+}
+
+BigInteger Rational::leading(const BigInteger &big, size_t count) {
+    const DigitVector &digits = big.raw();
+    if (digits.size() <= count)
+        return big;
+
+    std::string s;
+    for (size_t i = 1; i <= count; ++i)
+        s += static_cast<char>('0' + digits[digits.size() - i]);
+
+    return BigInteger(s);
+}
+
+// Both parts are kept reduced with a positive denominator, so equal values
+// have equal parts.
+size_t Rational::hash() const {
+    size_t h = numerator_.hash();
+
+    return h ^ (denominator_.hash() + 0x9e3779b9 + (h << 6) + (h >> 2));
+}
+
+Rational::operator double() const {
+    if (!numerator_)
+        return 0;
+
+    bool negative = numerator_.isNegative() != denominator_.isNegative();
+    BigInteger numerator(numerator_.abs()), denominator(denominator_.abs());
+
+    // Long operands are cut to their leading digits first. The value lies
+    // between the quotients of the cut operands rounded down and up, and if
+    // both of them round to the same double, so does the value.
+    const size_t digits = 40;
+    if (numerator.size() > digits || denominator.size() > digits) {
+        BigInteger n(leading(numerator, digits)), d(leading(denominator, digits));
+        long long scale = static_cast<long long>(numerator.size() - n.size()) -
+                          static_cast<long long>(denominator.size() - d.size());
+        if (scale > 320)
+            return negative ? -HUGE_VAL : HUGE_VAL;
+        if (scale < -340)
+            return negative ? -0.0 : 0.0;
+
+        BigInteger nUp(n.size() < numerator.size() ? n + 1 : n), dUp(d.size() < denominator.size() ? d + 1 : d);
+        if (scale > 0) {
+            n.fill(static_cast<size_t>(scale));
+            nUp.fill(static_cast<size_t>(scale));
+        } else {
+            d.fill(static_cast<size_t>(-scale));
+            dUp.fill(static_cast<size_t>(-scale));
+        }
+
+        double lower = quotient(n, dUp), upper = quotient(nUp, d);
+        if (lower == upper)
+            return negative ? -lower : lower;
+    }
+
+    double d = quotient(numerator, denominator);
+
+    return negative ? -d : d;
+}
+
+Rational Rational::reduced(const BigInteger &numerator, const BigInteger &denominator) {
+    Rational temp;
+    temp.numerator_ = numerator;
+    temp.denominator_ = denominator;
+    if (denominator.isNegative()) {
+        temp.numerator_ = -numerator;
+        temp.denominator_ = -denominator;
+    }
+
+    return temp;
+}
+
+ContinuedFraction Rational::continuedFraction() const {
+    return ContinuedFraction(numerator_, denominator_);
+}
+
+Rational Rational::fromContinuedFraction(const std::vector<BigInteger> &quotients) {
+    if (quotients.empty())
+        return Rational();
+
+    BigInteger h(quotients[quotients.size() - 1]), k(1);
+    for (size_t i = quotients.size() - 1; i > 0; --i) {
+        BigInteger t(quotients[i - 1] * h + k);
+        k = h;
+        h = t;
+    }
+
+    return reduced(h, k);
+}
+
+Rational Rational::limitDenominator(const BigInteger &maxDenominator) const {
+    if (denominator_ <= maxDenominator)
+        return *this;
+
+    // Convergents p1/q1 follow p0/q0; the answer is either the last one whose
+    // denominator fits or the best semiconvergent after it.
+    BigInteger p0(0), q0(1), p1(1), q1(0), a;
+    ContinuedFraction fraction(continuedFraction());
+    while (fraction.next(a)) {
+        BigInteger q2(q0 + a * q1);
+        if (q2 > maxDenominator)
+            break;
+        BigInteger p2(p0 + a * p1);
+        p0 = p1;
+        q0 = q1;
+        p1 = p2;
+        q1 = q2;
+    }
+
+    BigInteger k((maxDenominator - q0) / q1);
+    Rational semiconvergent(reduced(p0 + k * p1, q0 + k * q1)), convergent(reduced(p1, q1));
+
+    Rational left(semiconvergent), right(convergent);
+    left -= *this;
+    right -= *this;
+    if (left < 0)
+        left = -left;
+    if (right < 0)
+        right = -right;
+
+    return right <= left ? convergent : semiconvergent;
+}
+
+std::string Rational::toString() const {
+    std::string s;
+
+    s += numerator_.toString();
+    if (denominator_ != 1)
+        s += '/' + denominator_.toString();
+
+    return s;
+}
+
+Rational& Rational::operator+=(const Rational right) {
+    NUMERICAL_OPERATION(OperationRationalAdd, numerator_.size() + denominator_.size());
+    BigInteger t(right.numerator_);
+    numerator_ *= right.denominator_;
+    t *= denominator_;
+    denominator_ *= right.denominator_;
+
+    numerator_ += t;
+
+    BigInteger g(gcd(numerator_, denominator_));
+
+    numerator_ /= g;
+    denominator_ /= g;
+
+    return *this;
+}
+
+Rational& Rational::operator-=(const Rational right) {
+    return *this += -right;
+}
+
+// Fractions are kept reduced with a positive denominator, so the sign, the
+// digit counts and the leading digits usually settle the order before the
+// two cross products are needed.
+bool Rational::operator<(const Rational &right) const {
+    NUMERICAL_OPERATION(OperationRationalCompare, numerator_.size() + denominator_.size());
+    if (numerator_.isNegative() != right.numerator_.isNegative())
+        return numerator_.isNegative();
+    if (!numerator_ || !right.numerator_)
+        return static_cast<bool>(right.numerator_);
+    if (denominator_ == right.denominator_)
+        return numerator_ < right.numerator_;
+    if (numerator_ == right.numerator_)
+        return numerator_.isNegative() ? denominator_ < right.denominator_ : denominator_ > right.denominator_;
+
+    // log10 |this / right| is the difference of digit counts plus a
+    // correction in (-2, 2) from the leading digits.
+    bool negative = numerator_.isNegative();
+    long long lengths = static_cast<long long>(numerator_.size()) - static_cast<long long>(denominator_.size()) -
+                        static_cast<long long>(right.numerator_.size()) +
+                        static_cast<long long>(right.denominator_.size());
+    if (lengths >= 2 || lengths <= -2)
+        return (lengths < 0) != negative;
+
+    double estimate = static_cast<double>(lengths) + fraction(numerator_) - fraction(denominator_) -
+                      fraction(right.numerator_) + fraction(right.denominator_);
+    if (estimate > 1e-9 || estimate < -1e-9)
+        return (estimate < 0) != negative;
+
+    return (numerator_ * right.denominator_ < right.numerator_ * denominator_);
+}
+
+bool Rational::operator>(const Rational &right) const {
+    return right < *this;
+}
+
+bool Rational::operator<=(const Rational &right) const {
+    return !(*this > right);
+}
+
+bool Rational::operator>=(const Rational &right) const {
+    return !(*this < right);
+}
+
+bool Rational::operator==(const Rational &right) const {
+    return numerator_ == right.numerator_ && denominator_ == right.denominator_;
+}
+
+bool Rational::operator!=(const Rational &right) const {
+    return !(*this == right);
+}
+
+Rational& Rational::operator*=(const Rational right) {
+    NUMERICAL_OPERATION(OperationRationalMultiply, numerator_.size() + denominator_.size());
+    numerator_ *= right.numerator_;
+    denominator_ *= right.denominator_;
+    BigInteger g(gcd(numerator_, denominator_));
+    numerator_ /= g;
+    denominator_ /= g;
+
+    return *this;
+}
+
+Rational& Rational::operator/=(const Rational right) {
+    NUMERICAL_OPERATION(OperationRationalDivide, numerator_.size() + denominator_.size());
+    numerator_ *= right.denominator_;
+    denominator_ *= right.numerator_;
+
+    BigInteger g(gcd(numerator_, denominator_));
+    numerator_ /= g;
+    denominator_ /= g;
+
+    if (denominator_ < 0) {
+        denominator_ = -denominator_;
+        numerator_ = -numerator_;
+    }
+
+    return *this;
+}
+
+Rational operator+(const Rational &left, const Rational &right) {
+    Rational temp(left);
+
+    return temp += right;
+}
+
+Rational operator-(const Rational &left, const Rational &right) {
+    Rational temp(left);
+
+    return temp -= right;
+}
+
+Rational operator/(const Rational &left, const Rational &right) {
+    Rational temp(left);
+
+    return temp /= right;
+}
+
+Rational operator*(const Rational &left, const Rational &right) {
+    Rational temp(left);
+
+    return temp *= right;
+}
+
+Rational& Rational::operator=(const Rational right) {
+    numerator_ = right.numerator_;
+    denominator_ = right.denominator_;
+
+    return *this;
+}
+
+DecimalExpansion::DecimalExpansion(const Rational &value)
+    : smallRemainder_(0), smallDenominator_(0), scaleDigits_(0) {
+    negative_ = value.numerator().isNegative();
+
+    BigInteger numerator(value.numerator().abs());
+    denominator_ = value.denominator().abs();
+    BigInteger quotient(numerator / denominator_);
+    remainder_ = numerator - quotient * denominator_;
+    integer_ = quotient.toString();
+
+    small_ = denominator_.size() < 19;
+    if (small_) {
+        smallRemainder_ = std::stoull(remainder_.toString());
+        smallDenominator_ = std::stoull(denominator_.toString());
+    }
+}
+
+size_t DecimalExpansion::next(char *digits, size_t count) {
+    size_t i = 0;
+    if (small_) {
+        for (; i < count && smallRemainder_ != 0; ++i) {
+            smallRemainder_ *= 10;
+            digits[i] = static_cast<char>('0' + smallRemainder_ / smallDenominator_);
+            smallRemainder_ %= smallDenominator_;
+        }
+        return i;
+    }
+
+    // A block of k digits is the quotient of remainder * 10^k by the
+    // denominator, zero padded on the left; once the remainder runs out the
+    // zeros trailing the last digit are not part of the expansion.
+    const size_t block = 1 << 8;
+    while (i < count && remainder_ && !executionCancelled()) {
+        size_t k = std::min(block, count - i);
+        if (k != scaleDigits_) {
+            scale_ = power(10, k);
+            scaleDigits_ = k;
+        }
+        BigInteger::multiply(remainder_, remainder_, scale_);
+        BigInteger::divmod(remainder_, denominator_, quotient_, remainder_);
+
+        const DigitVector &q = quotient_.raw();
+        size_t length = quotient_ ? q.size() : 0;
+        for (size_t j = 0; j < k; ++j)
+            digits[i + j] = static_cast<char>('0' + (k - 1 - j < length ? q[k - 1 - j] : 0));
+        if (!remainder_)
+            while (k > 0 && digits[i + k - 1] == '0')
+                --k;
+        i += k;
+    }
+
+    return i;
+}
+
+bool DecimalExpansion::finished() const {
+    return small_ ? smallRemainder_ == 0 : !remainder_;
+}
+
+int DecimalExpansion::compareHalf() const {
+    if (small_) {
+        unsigned long long twice = 2 * smallRemainder_;
+        return twice < smallDenominator_ ? -1 : twice > smallDenominator_;
+    }
+
+    BigInteger twice(remainder_ + remainder_);
+    return twice < denominator_ ? -1 : twice > denominator_;
+}
+
+size_t DecimalExpansion::preperiod() const {
+    BigInteger denominator(denominator_), two(2), five(5);
+    size_t twos = 0, fives = 0;
+    while (denominator > 1 && !(denominator % two)) {
+        denominator /= two;
+        ++twos;
+    }
+    while (denominator > 1 && !(denominator % five)) {
+        denominator /= five;
+        ++fives;
+    }
+
+    return max(twos, fives);
+}
+
+size_t DecimalExpansion::period(size_t limit) const {
+    DecimalExpansion walker(*this);
+    std::vector<char> skipped(preperiod() + 1);
+    walker.next(skipped.data(), skipped.size() - 1);
+    if (walker.finished())
+        return 0;
+
+    char digit;
+    if (small_) {
+        unsigned long long start = walker.smallRemainder_;
+        for (size_t length = 1; length <= limit; ++length) {
+            walker.next(&digit, 1);
+            if (walker.smallRemainder_ == start)
+                return length;
+        }
+        return 0;
+    }
+
+    BigInteger start(walker.remainder_);
+    for (size_t length = 1; length <= limit; ++length) {
+        walker.next(&digit, 1);
+        if (walker.remainder_ == start)
+            return length;
+    }
+
+    return 0;
+}
+
+void Rational::writeDecimal(size_t precision, const std::function<void(const char *, size_t)> &sink,
+                            bool rounded) const {
+    const size_t block = 1 << 16;
+
+    DecimalExpansion expansion(*this);
+    std::vector<char> digits(block);
+    std::string out;
+    out.reserve(2 * block);
+
+    auto flush = [&]() {
+        if (!out.empty())
+            sink(out.data(), out.size());
+        out.clear();
+    };
+    auto write = [&](const char *s, size_t n) {
+        out.append(s, n);
+        if (out.size() >= block)
+            flush();
+    };
+    auto repeat = [&](char c, size_t n) {
+        while (n > 0) {
+            size_t part = std::min(n, block);
+            out.append(part, c);
+            n -= part;
+            if (out.size() >= block)
+                flush();
+        }
+    };
+
+    if (numerator_ < 0)
+        out += '-';
+
+    // When rounding, a carry may run back through a tail of nines, so the last
+    // digit that is not a nine is held back together with the count of nines
+    // after it. Until the first such fractional digit it is the integer part.
+    std::string held(expansion.integerPart());
+    bool holdingInteger = true;
+    size_t nines = 0;
+    auto release = [&](char fill) {
+        write(held.data(), held.size());
+        if (holdingInteger && precision > 0)
+            out += '.';
+        repeat(fill, nines);
+        nines = 0;
+    };
+    if (!rounded) {
+        release('9');
+        held.clear();
+        holdingInteger = false;
+    }
+
+    size_t produced = 0;
+    ProgressReporter progress(precision);
+    while (produced < precision) {
+        size_t n = expansion.next(digits.data(), std::min(block, precision - produced));
+        if (n == 0)
+            break;
+        produced += n;
+        progress.advance(n);
+
+        if (!rounded) {
+            write(digits.data(), n);
+            continue;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            if (digits[i] == '9') {
+                ++nines;
+                continue;
+            }
+            release('9');
+            held.assign(1, digits[i]);
+            holdingInteger = false;
+        }
+    }
+
+    bool carry = false;
+    if (rounded && produced == precision) {
+        int half = expansion.compareHalf();
+        char last = nines > 0 ? '9' : held[held.size() - 1];
+        carry = half > 0 || (half == 0 && (last - '0') % 2 == 1);
+    }
+    if (carry) {
+        size_t i = held.size();
+        while (i > 0 && held[i - 1] == '9')
+            held[--i] = '0';
+        if (i == 0)
+            held.insert(held.begin(), '1');
+        else
+            ++held[i - 1];
+    }
+    release(carry ? '0' : '9');
+    repeat('0', precision - produced);
+    if (produced < precision)
+        progress.advance(precision - produced);
+
+    flush();
+}
+
+std::string Rational::asDecimal(size_t precision, bool rounded) const {
+    std::string s;
+    writeDecimal(precision, [&s](const char *digits, size_t count) { s.append(digits, count); }, rounded);
+
+    return s;
+}
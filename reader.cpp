@@ -0,0 +1,245 @@
+//
+// Created by gosktin on 19.10.26.
+//
+
+#include <fstream>
+#include <functional>
+#include <thread>
+
+#include "reader.h"
+
+static bool isSpace(char c) {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+NumberReader::NumberReader(std::istream &in, size_t bufferSize) : in_(in), buffer_(max(bufferSize, size_t(1))),
+        begin_(0), end_(0), offset_(0), line_(1), column_(1), stop_(static_cast<size_t>(-1)), failed_(false) {}
+
+void NumberReader::setRange(size_t start, size_t stop) {
+    offset_ = start;
+    stop_ = stop;
+}
+
+bool NumberReader::peek(char &c) {
+    if (begin_ == end_) {
+        in_.read(buffer_.data(), buffer_.size());
+        begin_ = 0;
+        end_ = static_cast<size_t>(in_.gcount());
+        if (end_ == 0)
+            return false;
+    }
+    c = buffer_[begin_];
+
+    return true;
+}
+
+void NumberReader::advance() {
+    if (buffer_[begin_] == '\n') {
+        ++line_;
+        column_ = 1;
+    } else
+        ++column_;
+    ++offset_;
+    ++begin_;
+}
+
+bool NumberReader::fail(const std::string &message) {
+    failed_ = true;
+    error_.offset = offset_;
+    error_.line = line_;
+    error_.column = column_;
+    error_.message = message;
+
+    char c;
+    while (peek(c) && !isSpace(c))
+        advance();
+
+    return false;
+}
+
+bool NumberReader::scanDigits(std::string &digits, bool fraction) {
+    size_t first = digits.size();
+    bool seen = false;
+    char c;
+    while (peek(c) && !isSpace(c)) {
+        if (c == '/' && fraction)
+            break;
+        if (c < '0' || c > '9')
+            return fail(std::string("unexpected character '") + c + "'");
+        if (c != '0' || digits.size() != first)
+            digits.push_back(c);
+        seen = true;
+        advance();
+    }
+    if (!seen)
+        return fail("expected a digit");
+    if (digits.size() == first)
+        digits = "0";
+
+    return true;
+}
+
+bool NumberReader::scan(bool fraction) {
+    failed_ = false;
+    numerator_.clear();
+    denominator_.clear();
+
+    char c;
+    while (peek(c) && isSpace(c))
+        advance();
+    if (begin_ == end_ || offset_ >= stop_)
+        return false;
+
+    if (c == '-') {
+        numerator_.push_back('-');
+        advance();
+    } else if (c == '+')
+        advance();
+    if (!scanDigits(numerator_, fraction))
+        return false;
+
+    if (peek(c) && c == '/') {
+        advance();
+        size_t offset = offset_, line = line_, column = column_;
+        if (!scanDigits(denominator_, false))
+            return false;
+        if (denominator_ == "0") {
+            fail("zero denominator");
+            error_.offset = offset;
+            error_.line = line;
+            error_.column = column;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool NumberReader::next(BigInteger &value) {
+    if (!scan(false))
+        return false;
+    value = BigInteger(numerator_);
+
+    return true;
+}
+
+bool NumberReader::next(Rational &value) {
+    if (!scan(true))
+        return false;
+    if (denominator_.empty())
+        value = Rational(BigInteger(numerator_));
+    else
+        value = Rational(BigInteger(numerator_), BigInteger(denominator_));
+
+    return true;
+}
+
+// Recomputes line and column of errors found by readers that started in the
+// middle of the file. Errors are rare, so a second sequential pass is cheaper
+// than tracking lines across chunks.
+void locateErrors(const std::string &path, std::vector<ParseError> &errors) {
+    std::ifstream in(path.c_str(), std::ios::binary);
+    size_t offset = 0, line = 1, column = 1;
+    char c;
+    for (size_t i = 0; i < errors.size(); ++i) {
+        while (offset < errors[i].offset && in.get(c)) {
+            if (c == '\n') {
+                ++line;
+                column = 1;
+            } else
+                ++column;
+            ++offset;
+        }
+        errors[i].line = line;
+        errors[i].column = column;
+    }
+}
+
+template <typename T>
+void readRange(const std::string &path, size_t start, size_t stop, std::vector<T> &values,
+               std::vector<ParseError> &errors) {
+    std::ifstream in(path.c_str(), std::ios::binary);
+    in.seekg(static_cast<std::streamoff>(start));
+
+    NumberReader reader(in);
+    reader.setRange(start, stop);
+    T value;
+    while (true) {
+        if (reader.next(value))
+            values.push_back(value);
+        else if (reader.failed())
+            errors.push_back(reader.error());
+        else
+            break;
+    }
+}
+
+template <typename T>
+bool readNumbers(const std::string &path, std::vector<T> &values, std::vector<ParseError> &errors, unsigned threads) {
+    const size_t minimalChunk = 1 << 22;
+
+    std::ifstream in(path.c_str(), std::ios::binary);
+    if (!in) {
+        ParseError error = {0, 0, 0, "cannot open " + path};
+        errors.push_back(error);
+        return false;
+    }
+    in.seekg(0, std::ios::end);
+    size_t length = static_cast<size_t>(in.tellg());
+
+    if (threads == 0)
+        threads = max(std::thread::hardware_concurrency(), 1u);
+    size_t chunks = std::min(static_cast<size_t>(threads), length / minimalChunk + 1);
+
+    // A chunk boundary is moved forward to the start of the next token, so
+    // every token is read by exactly one reader.
+    std::vector<size_t> bounds(1, 0);
+    for (size_t k = 1; k < chunks; ++k) {
+        size_t bound = max(length * k / chunks, bounds.back());
+        in.clear();
+        in.seekg(static_cast<std::streamoff>(bound - 1));
+        char c;
+        while (in.get(c) && !isSpace(c))
+            ++bound;
+        bounds.push_back(std::min(bound, length));
+    }
+    bounds.push_back(length);
+
+    std::vector<std::vector<T> > parts(chunks);
+    std::vector<std::vector<ParseError> > failures(chunks);
+    std::vector<std::thread> workers;
+    for (size_t k = 1; k < chunks; ++k)
+        workers.push_back(std::thread(readRange<T>, std::cref(path), bounds[k], bounds[k + 1],
+                                      std::ref(parts[k]), std::ref(failures[k])));
+    readRange(path, bounds[0], bounds[1], parts[0], failures[0]);
+    for (size_t k = 0; k < workers.size(); ++k)
+        workers[k].join();
+
+    size_t firstError = errors.size();
+    for (size_t k = 0; k < chunks; ++k) {
+        values.insert(values.end(), parts[k].begin(), parts[k].end());
+        errors.insert(errors.end(), failures[k].begin(), failures[k].end());
+    }
+    if (chunks > 1 && errors.size() > firstError) {
+        std::vector<ParseError> found(errors.begin() + firstError, errors.end());
+        locateErrors(path, found);
+        std::copy(found.begin(), found.end(), errors.begin() + firstError);
+    }
+
+    return errors.size() == firstError;
+}
+
+template bool readNumbers(const std::string &path, std::vector<BigInteger> &values,
+                          std::vector<ParseError> &errors, unsigned threads);
+template bool readNumbers(const std::string &path, std::vector<Rational> &values,
+                          std::vector<ParseError> &errors, unsigned threads);
+
+bool readIntegers(const std::string &path, std::vector<BigInteger> &values, std::vector<ParseError> &errors,
+                  unsigned threads) {
+    return readNumbers(path, values, errors, threads);
+}
+
+bool readRationals(const std::string &path, std::vector<Rational> &values, std::vector<ParseError> &errors,
+                   unsigned threads) {
+    return readNumbers(path, values, errors, threads);
+}
@@ -0,0 +1,81 @@
+//
+// Created by gosktin on 19.10.26.
+//
+
+#ifndef READER_H
+#define READER_H
+
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "rational.h"
+
+struct ParseError {
+    size_t offset;
+    size_t line;
+    size_t column;
+    std::string message;
+};
+
+// Reads whitespace separated integers and p/q fractions from a stream through
+// a large buffer of its own. Every token is validated while it is scanned,
+// its leading zeros dropped, into digit strings reused from token to token,
+// which are then parsed into the BigInteger.
+//
+// next() returns false both at the end of input and on a malformed token; in
+// the latter case failed() is set, error() holds the position and the reader
+// resumes with the token after the bad one on the following call.
+class NumberReader {
+public:
+    explicit NumberReader(std::istream &in, size_t bufferSize = 1 << 20);
+
+    bool next(BigInteger &value);
+    bool next(Rational &value);
+
+    bool failed() const { return failed_; }
+    const ParseError &error() const { return error_; }
+
+    // The stream is positioned at byte `start` of the input; tokens starting
+    // at `stop` or later are left to whoever reads the next range.
+    void setRange(size_t start, size_t stop);
+
+private:
+    std::istream &in_;
+    std::vector<char> buffer_;
+    size_t begin_;
+    size_t end_;
+    size_t offset_;
+    size_t line_;
+    size_t column_;
+    size_t stop_;
+    bool failed_;
+    ParseError error_;
+    std::string numerator_;
+    std::string denominator_;
+
+    bool peek(char &c);
+    void advance();
+    bool scan(bool fraction);
+    bool scanDigits(std::string &digits, bool fraction);
+    bool fail(const std::string &message);
+};
+
+// Recomputes line and column of errors found by readers that started in the
+// middle of the file.
+void locateErrors(const std::string &path, std::vector<ParseError> &errors);
+
+// Reads the whole file, splitting it between `threads` readers (0 means one per
+// hardware thread). Values are appended in file order; returns false if the
+// file could not be opened or contained malformed tokens. Instantiated for
+// BigInteger and Rational.
+template <typename T>
+bool readNumbers(const std::string &path, std::vector<T> &values, std::vector<ParseError> &errors,
+                 unsigned threads = 1);
+
+bool readIntegers(const std::string &path, std::vector<BigInteger> &values, std::vector<ParseError> &errors,
+                  unsigned threads = 1);
+bool readRationals(const std::string &path, std::vector<Rational> &values, std::vector<ParseError> &errors,
+                   unsigned threads = 1);
+
+#endif //READER_H
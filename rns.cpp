@@ -0,0 +1,272 @@
+//
+// Created by gosktin on 19.10.26.
+//
+
+#include <mutex>
+
+#include "rns.h"
+
+unsigned long long residueModulo(const BigInteger &value, unsigned long long modulus) {
+    const DigitVector &digits = value.raw();
+    unsigned long long r = 0;
+    for (size_t i = digits.size(); i > 0; --i)
+        r = (r * 10 + static_cast<unsigned long long>(digits[i - 1])) % modulus;
+
+    return value.isNegative() && r ? modulus - r : r;
+}
+
+unsigned long long powerModulo(unsigned long long base, unsigned long long exponent, unsigned long long modulus) {
+    unsigned long long result = 1 % modulus;
+    base %= modulus;
+    while (exponent) {
+        if (exponent & 1)
+            result = result * base % modulus;
+        base = base * base % modulus;
+        exponent >>= 1;
+    }
+
+    return result;
+}
+
+// Miller-Rabin with the bases 2, 7 and 61 is exact below 4759123141.
+static bool isWordPrime(unsigned long long n) {
+    if (n < 2 || n % 2 == 0)
+        return n == 2;
+
+    unsigned long long d = n - 1;
+    int s = 0;
+    while (d % 2 == 0) {
+        d /= 2;
+        ++s;
+    }
+
+    static const unsigned long long bases[] = {2, 7, 61};
+    for (size_t k = 0; k < 3; ++k) {
+        if (bases[k] % n == 0)
+            continue;
+        unsigned long long x = powerModulo(bases[k], d, n);
+        if (x == 1 || x == n - 1)
+            continue;
+        bool composite = true;
+        for (int i = 1; i < s && composite; ++i) {
+            x = x * x % n;
+            composite = x != n - 1;
+        }
+        if (composite)
+            return false;
+    }
+
+    return true;
+}
+
+std::vector<unsigned> wordPrimes(size_t count) {
+    static std::mutex mutex;
+    static std::vector<unsigned> found;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    unsigned candidate = found.empty() ? 2147483647u : found.back() - 2;
+    while (found.size() < count) {
+        if (isWordPrime(candidate))
+            found.push_back(candidate);
+        candidate -= 2;
+    }
+
+    return std::vector<unsigned>(found.begin(), found.begin() + count);
+}
+
+// Every prime is above 10^9, so `digits` / 9 of them cover 10^digits and one
+// more covers the factor of two for the sign.
+size_t PrimeBasis::primesForDigits(size_t digits) {
+    return digits / 9 + 2;
+}
+
+PrimeBasis::PrimeBasis(size_t count) : primes_(wordPrimes(max(count, static_cast<size_t>(1)))) {
+    levels_.push_back(std::vector<BigInteger>());
+    for (size_t i = 0; i < primes_.size(); ++i)
+        levels_[0].push_back(BigInteger(static_cast<int>(primes_[i])));
+    while (levels_.back().size() > 1) {
+        const std::vector<BigInteger> &below = levels_.back();
+        std::vector<BigInteger> level;
+        for (size_t i = 0; i + 1 < below.size(); i += 2)
+            level.push_back(below[i] * below[i + 1]);
+        if (below.size() % 2)
+            level.push_back(below.back());
+        levels_.push_back(level);
+    }
+
+    // Below nodes of four primes the word arithmetic is cheaper.
+    lowestContext_ = std::min(levels_.size() - 1, static_cast<size_t>(2));
+    contexts_.resize(levels_.size());
+    for (size_t h = lowestContext_; h < levels_.size(); ++h)
+        for (size_t i = 0; i < levels_[h].size(); ++i)
+            contexts_[h].push_back(ReductionContext(levels_[h][i]));
+
+    // The product of everything outside a node, reduced by the node, goes
+    // down the tree; a node's sibling is the part of it the children share.
+    std::vector<BigInteger> cofactors(1, BigInteger(1));
+    for (size_t h = levels_.size() - 1; h > lowestContext_; --h) {
+        std::vector<BigInteger> below(levels_[h - 1].size());
+        for (size_t i = 0; i < levels_[h].size(); ++i) {
+            size_t left = 2 * i, right = 2 * i + 1;
+            if (right == below.size()) {
+                below[left] = cofactors[i];
+                continue;
+            }
+            below[left] = contexts_[h - 1][left].reduce(cofactors[i] * levels_[h - 1][right]);
+            below[right] = contexts_[h - 1][right].reduce(cofactors[i] * levels_[h - 1][left]);
+        }
+        cofactors.swap(below);
+    }
+
+    size_t width = static_cast<size_t>(1) << lowestContext_;
+    inverses_.resize(primes_.size());
+    for (size_t i = 0; i < primes_.size(); ++i) {
+        unsigned long long p = primes_[i], product = residueModulo(cofactors[i / width], p);
+        for (size_t j = i / width * width; j < std::min((i / width + 1) * width, primes_.size()); ++j)
+            if (j != i)
+                product = product * (primes_[j] % p) % p;
+        inverses_[i] = static_cast<unsigned>(powerModulo(product, p - 2, p));
+    }
+}
+
+void PrimeBasis::toResidues(const BigInteger &value, unsigned *residues) const {
+    size_t top = levels_.size() - 1;
+    std::vector<BigInteger> remainders(1, contexts_[top][0].reduce(value.abs()));
+    for (size_t h = top; h > lowestContext_; --h) {
+        std::vector<BigInteger> below(levels_[h - 1].size());
+        for (size_t i = 0; i < below.size(); ++i)
+            below[i] = contexts_[h - 1][i].reduce(remainders[i / 2]);
+        remainders.swap(below);
+    }
+
+    size_t width = static_cast<size_t>(1) << lowestContext_;
+    for (size_t i = 0; i < primes_.size(); ++i) {
+        unsigned r = static_cast<unsigned>(residueModulo(remainders[i / width], primes_[i]));
+        residues[i] = value.isNegative() && r ? primes_[i] - r : r;
+    }
+}
+
+// x = sum of c_i * M / p_i with c_i = r_i * (M / p_i)^-1 mod p_i, summed up
+// the tree: a node's sum is left * product(right) + right * product(left).
+BigInteger PrimeBasis::fromResidues(const unsigned *residues) const {
+    std::vector<BigInteger> sums;
+    for (size_t i = 0; i < primes_.size(); ++i) {
+        unsigned long long c = static_cast<unsigned long long>(residues[i]) * inverses_[i] % primes_[i];
+        sums.push_back(BigInteger(static_cast<int>(c)));
+    }
+    for (size_t h = 0; h + 1 < levels_.size(); ++h) {
+        std::vector<BigInteger> above;
+        for (size_t i = 0; i + 1 < sums.size(); i += 2)
+            above.push_back(sums[i] * levels_[h][i + 1] + sums[i + 1] * levels_[h][i]);
+        if (sums.size() % 2)
+            above.push_back(sums.back());
+        sums.swap(above);
+    }
+
+    BigInteger x(contexts_.back()[0].reduce(sums[0]));
+    if (x * 2 >= modulus())
+        x -= modulus();
+
+    return x;
+}
+
+ResidueNumber::ResidueNumber(const PrimeBasis &basis) : basis_(&basis), residues_(basis.size(), 0) {}
+
+ResidueNumber::ResidueNumber(const PrimeBasis &basis, const BigInteger &value) :
+        basis_(&basis), residues_(basis.size()) {
+    basis.toResidues(value, residues_.data());
+}
+
+// The loops below are branch-free per element and run over plain arrays, so
+// additions and subtractions vectorize.
+ResidueNumber &ResidueNumber::operator+=(const ResidueNumber &right) {
+    const unsigned *p = basis_->primes().data();
+    for (size_t i = 0; i < residues_.size(); ++i) {
+        unsigned s = residues_[i] + right.residues_[i];
+        residues_[i] = s >= p[i] ? s - p[i] : s;
+    }
+
+    return *this;
+}
+
+ResidueNumber &ResidueNumber::operator-=(const ResidueNumber &right) {
+    const unsigned *p = basis_->primes().data();
+    for (size_t i = 0; i < residues_.size(); ++i) {
+        unsigned s = residues_[i] - right.residues_[i];
+        residues_[i] = residues_[i] >= right.residues_[i] ? s : s + p[i];
+    }
+
+    return *this;
+}
+
+ResidueNumber &ResidueNumber::operator*=(const ResidueNumber &right) {
+    const unsigned *p = basis_->primes().data();
+    for (size_t i = 0; i < residues_.size(); ++i)
+        residues_[i] = static_cast<unsigned>(static_cast<unsigned long long>(residues_[i]) * right.residues_[i] % p[i]);
+
+    return *this;
+}
+
+ResidueNumber ResidueNumber::operator-() const {
+    ResidueNumber result(*basis_);
+
+    return result -= *this;
+}
+
+ResidueNumber ResidueNumber::operator+(const ResidueNumber &right) const {
+    ResidueNumber temp(*this);
+
+    return temp += right;
+}
+
+ResidueNumber ResidueNumber::operator-(const ResidueNumber &right) const {
+    ResidueNumber temp(*this);
+
+    return temp -= right;
+}
+
+ResidueNumber ResidueNumber::operator*(const ResidueNumber &right) const {
+    ResidueNumber temp(*this);
+
+    return temp *= right;
+}
+
+BigInteger ResidueNumber::toBigInteger() const {
+    return basis_->fromResidues(residues_.data());
+}
+
+bool ResidueNumber::toRational(Rational &result) const {
+    BigInteger value(toBigInteger());
+    if (value.isNegative())
+        value += basis_->modulus();
+
+    return reconstructRational(value, basis_->modulus(), result);
+}
+
+// The extended Euclidean algorithm on (modulus, value), stopped at the
+// first remainder below the bound (Wang's algorithm).
+bool reconstructRational(const BigInteger &value, const BigInteger &modulus, Rational &result) {
+    if (modulus.size() < 2 && modulus < 3)
+        return false;
+
+    size_t f = modulus.size() >= 2 ? (modulus.size() - 2) / 2 : 0;
+    BigInteger bound(power(BigInteger(10), f));
+
+    BigInteger r0(modulus), r1(value), t0(0), t1(1), quotient, remainder;
+    while (r1 >= bound) {
+        BigInteger::divmod(r0, r1, quotient, remainder);
+        r0 = r1;
+        r1 = remainder;
+        BigInteger t(t0 - quotient * t1);
+        t0 = t1;
+        t1 = t;
+    }
+    if (!t1 || t1.abs() >= bound)
+        return false;
+
+    if (gcd(r1, t1) != BigInteger(1))
+        return false;
+
+    result = Rational(t1.isNegative() ? -r1 : r1, t1.abs());
+    return true;
+}
@@ -0,0 +1,94 @@
+//
+// Created by gosktin on 19.10.26.
+//
+
+#ifndef RNS_H
+#define RNS_H
+
+#include <cstddef>
+#include <vector>
+
+#include "array.h"
+#include "rational.h"
+
+// Word-sized modular arithmetic shared by the multi-modular algorithms.
+// Moduli are below 2^31, so every product fits in 64 bits.
+unsigned long long residueModulo(const BigInteger &value, unsigned long long modulus);
+unsigned long long powerModulo(unsigned long long base, unsigned long long exponent, unsigned long long modulus);
+// The `count` largest primes below 2^31, in decreasing order.
+std::vector<unsigned> wordPrimes(size_t count);
+
+// A set of word primes together with the subproduct tree of their products.
+// Going to residues reduces the value down the tree, going back combines
+// the residues up the same tree (Chinese remainder theorem), so both ways
+// cost a few multiplications of the size of the product per tree level
+// instead of one long division per prime.
+//
+// Values are represented in the symmetric range [-M/2, M/2), M being the
+// product of the primes. A basis is expensive to set up and meant to be
+// shared by many values.
+class PrimeBasis {
+public:
+    explicit PrimeBasis(size_t count);
+
+    // Enough primes for integers of up to `digits` digits of either sign.
+    static size_t primesForDigits(size_t digits);
+
+    size_t size() const { return primes_.size(); }
+    unsigned prime(size_t i) const { return primes_[i]; }
+    const std::vector<unsigned> &primes() const { return primes_; }
+    const BigInteger &modulus() const { return levels_.back()[0]; }
+
+    // value mod every prime, as numbers in [0, p).
+    void toResidues(const BigInteger &value, unsigned *residues) const;
+    BigInteger fromResidues(const unsigned *residues) const;
+
+private:
+    std::vector<unsigned> primes_;
+    // levels_[0] holds the primes, every further level the products of
+    // pairs from the one below; an odd node is carried up unchanged.
+    std::vector<std::vector<BigInteger> > levels_;
+    // Reduction by the nodes of levels_[h] for h >= lowestContext_.
+    std::vector<std::vector<ReductionContext> > contexts_;
+    size_t lowestContext_;
+    // (M / p_i)^-1 mod p_i.
+    std::vector<unsigned> inverses_;
+};
+
+// An integer as its residues over a PrimeBasis, which must outlive it.
+// Addition, subtraction and multiplication are independent word operations
+// per prime over contiguous arrays; the result is exact as long as the true
+// value stays within the symmetric range of the basis.
+class ResidueNumber {
+public:
+    explicit ResidueNumber(const PrimeBasis &basis);
+    ResidueNumber(const PrimeBasis &basis, const BigInteger &value);
+
+    ResidueNumber &operator+=(const ResidueNumber &right);
+    ResidueNumber &operator-=(const ResidueNumber &right);
+    ResidueNumber &operator*=(const ResidueNumber &right);
+
+    ResidueNumber operator-() const;
+    ResidueNumber operator+(const ResidueNumber &right) const;
+    ResidueNumber operator-(const ResidueNumber &right) const;
+    ResidueNumber operator*(const ResidueNumber &right) const;
+
+    const std::vector<unsigned> &residues() const { return residues_; }
+
+    BigInteger toBigInteger() const;
+    // The fraction n/d with |n|, d small enough to be the only one
+    // congruent to this value; false if there is none.
+    bool toRational(Rational &result) const;
+
+private:
+    const PrimeBasis *basis_;
+    std::vector<unsigned> residues_;
+};
+
+// Finds n/d with n = d * value (mod modulus), |n| < 10^f and 0 < d < 10^f,
+// where f is half the digit count of `modulus` less one, so that
+// 2 * 10^2f < modulus and such a fraction is unique if it exists. `value`
+// must lie in [0, modulus).
+bool reconstructRational(const BigInteger &value, const BigInteger &modulus, Rational &result);
+
+#endif //RNS_H
@@ -0,0 +1,198 @@
+//
+// Created by gosktin on 19.10.26.
+//
+
+#include <cmath>
+#include <string>
+
+#include "array.h"
+#include "execution.h"
+#include "parallel.h"
+#include "series.h"
+
+// Ranges of fewer terms are split on the calling thread.
+static const size_t parallelTerms = 64;
+// Digits carried beyond those asked for by the constants, so that the
+// truncation is right unless all of them are nines.
+static const size_t guardDigits = 10;
+
+// `negative` prefixes the sign even when the digits are all zero, as
+// Rational::asDecimal does.
+static std::string decimalText(const BigInteger &scaled, size_t digits, bool negative) {
+    std::string text(scaled.abs().toString());
+    if (digits > 0) {
+        if (text.size() <= digits)
+            text.insert(0, digits + 1 - text.size(), '0');
+        text.insert(text.size() - digits, ".");
+    }
+
+    return negative ? "-" + text : text;
+}
+
+HypergeometricSeries::HypergeometricSeries(const Term &a, const Term &b, const Term &p, const Term &q) :
+        a_(a), b_(b), p_(p), q_(q) {}
+
+// A cancelled range comes out as the empty one, P = Q = B = 1 and T = 0, so
+// that what is built on it never divides by zero.
+void HypergeometricSeries::split(size_t begin, size_t end, Split &result, ProgressReporter &progress) const {
+    if (executionCancelled()) {
+        result.p = result.q = result.b = 1;
+        result.t = 0;
+        return;
+    }
+    if (end - begin == 1) {
+        result.p = p_(begin);
+        result.q = q_(begin);
+        result.b = b_(begin);
+        result.t = a_(begin) * result.p;
+        progress.advance();
+        return;
+    }
+
+    size_t middle = begin + (end - begin) / 2;
+    Split left, right;
+    if (end - begin < parallelTerms) {
+        split(begin, middle, left, progress);
+        split(middle, end, right, progress);
+    } else {
+        TaskGroup group;
+        group.run([&]() { split(begin, middle, left, progress); });
+        split(middle, end, right, progress);
+        group.wait();
+    }
+
+    result.t = right.b * right.q * left.t + left.b * left.p * right.t;
+    result.p = left.p * right.p;
+    result.q = left.q * right.q;
+    result.b = left.b * right.b;
+}
+
+Rational HypergeometricSeries::sum(size_t terms) const {
+    if (terms == 0)
+        return Rational(0);
+
+    Split s;
+    ProgressReporter progress(terms);
+    split(0, terms, s, progress);
+
+    return Rational(s.t, s.b * s.q);
+}
+
+// T 10^digits / (B Q) with the division done by Barrett reduction, which
+// for a million digits is the difference between seconds and hours.
+BigInteger HypergeometricSeries::scaled(size_t terms, size_t digits) const {
+    if (terms == 0)
+        return BigInteger(0);
+
+    Split s;
+    ProgressReporter progress(terms);
+    split(0, terms, s, progress);
+    BigInteger denominator(s.b * s.q), quotient, remainder;
+    ReductionContext(denominator).divmod(s.t.shiftLeft(digits), quotient, remainder);
+
+    return denominator.isNegative() ? -quotient : quotient;
+}
+
+std::string HypergeometricSeries::asDecimal(size_t terms, size_t digits) const {
+    if (terms == 0)
+        return decimalText(BigInteger(0), digits, false);
+
+    Split s;
+    ProgressReporter progress(terms);
+    split(0, terms, s, progress);
+    BigInteger denominator(s.b * s.q), quotient, remainder;
+    ReductionContext(denominator).divmod(s.t.shiftLeft(digits), quotient, remainder);
+
+    return decimalText(quotient, digits, s.t && s.t.isNegative() != denominator.isNegative());
+}
+
+// With r the root of the value without its lowest 2h digits, h being a
+// quarter of the length, the root of the whole is r 10^h + d, the step d
+// being about e / 2r for the remainder e = value - r^2 10^2h. d has only h
+// digits, so the division needs just the leading h digits of 2r and costs
+// half a length, and the new remainder e - d (2r 10^h + d) no full square.
+// Truncation leaves d a few units off, which the last loops walk away.
+BigInteger squareRoot(const BigInteger &value) {
+    if (value.size() <= 15) {
+        unsigned long long n = std::stoull(value.toString()),
+                root = static_cast<unsigned long long>(std::sqrt(static_cast<double>(n)));
+        while (root * root > n)
+            --root;
+        while ((root + 1) * (root + 1) <= n)
+            ++root;
+        return BigInteger(std::to_string(root));
+    }
+
+    size_t half = value.size() / 4;
+    BigInteger top(squareRoot(value.shiftRight(2 * half)));
+    BigInteger error(value - (top * top).shiftLeft(2 * half)), divisor(top * 2);
+    size_t cut = divisor.size() > half + guardDigits ? divisor.size() - half - guardDigits : 0;
+
+    BigInteger step, remainder;
+    ReductionContext(divisor.shiftRight(cut)).divmod(error.shiftRight(half + cut), step, remainder);
+    BigInteger root(top.shiftLeft(half) + step);
+    error -= step * (divisor.shiftLeft(half) + step);
+
+    while (error.isNegative() && !executionCancelled()) {
+        --root;
+        error += root * 2 + 1;
+    }
+    while (error > root * 2 && !executionCancelled()) {
+        error -= root * 2 + 1;
+        ++root;
+    }
+
+    return root;
+}
+
+// pi = 426880 sqrt(10005) / S with S the Chudnovsky series, whose term ratio
+// is -(6n - 5)(2n - 1)(6n - 1) / (n^3 640320^3 / 24).
+std::string piDecimal(size_t digits) {
+    size_t precision = digits + guardDigits;
+    HypergeometricSeries chudnovsky(
+            [](size_t n) { return BigInteger(13591409) + BigInteger(545140134) * BigInteger(static_cast<int>(n)); },
+            [](size_t) { return BigInteger(1); },
+            [](size_t n) {
+                if (n == 0)
+                    return BigInteger(1);
+                int k = static_cast<int>(n);
+                return -(BigInteger(6 * k - 5) * BigInteger(2 * k - 1) * BigInteger(6 * k - 1));
+            },
+            [](size_t n) {
+                if (n == 0)
+                    return BigInteger(1);
+                BigInteger k(static_cast<int>(n));
+                return k * k * k * BigInteger("10939058860032000");
+            });
+
+    BigInteger series(chudnovsky.scaled(precision / 14 + 2, precision));
+    BigInteger root(squareRoot(BigInteger(10005).shiftLeft(2 * precision))), pi, remainder;
+    ReductionContext(series).divmod((root * BigInteger(426880)).shiftLeft(precision), pi, remainder);
+
+    return decimalText(pi.shiftRight(guardDigits), digits, false);
+}
+
+std::string eDecimal(size_t digits) {
+    size_t precision = digits + guardDigits, terms = 1;
+    for (double magnitude = 0; magnitude <= static_cast<double>(precision) + 1; ++terms)
+        magnitude += std::log10(static_cast<double>(terms));
+
+    HypergeometricSeries exponential([](size_t) { return BigInteger(1); }, [](size_t) { return BigInteger(1); },
+                                     [](size_t) { return BigInteger(1); },
+                                     [](size_t n) { return BigInteger(n == 0 ? 1 : static_cast<int>(n)); });
+
+    return decimalText(exponential.scaled(terms, precision).shiftRight(guardDigits), digits, false);
+}
+
+// log 2 = 2 atanh(1 / 3) = 2 sum of 1 / ((2n + 1) 3^(2n + 1)), a digit
+// per term as 9^n grows.
+std::string log2Decimal(size_t digits) {
+    size_t precision = digits + guardDigits;
+    HypergeometricSeries atanh([](size_t) { return BigInteger(1); },
+                               [](size_t n) { return BigInteger(2 * static_cast<int>(n) + 1); },
+                               [](size_t) { return BigInteger(1); },
+                               [](size_t n) { return BigInteger(n == 0 ? 3 : 9); });
+
+    BigInteger log2(atanh.scaled(precision * 21 / 20 + 2, precision) * 2);
+    return decimalText(log2.shiftRight(guardDigits), digits, false);
+}
@@ -0,0 +1,58 @@
+//
+// Created by gosktin on 19.10.26.
+//
+
+#ifndef SERIES_H
+#define SERIES_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+#include "execution.h"
+#include "rational.h"
+
+// The series of a(n) / b(n) * p(0) ... p(n) / (q(0) ... q(n)) over n,
+// evaluated by binary splitting. The terms of a range [begin, end) combine
+// into integers P, Q, B and T with sum = T / (B Q), two halves joining as
+//
+//     P = Pl Pr, Q = Ql Qr, B = Bl Br, T = Br Qr Tl + Bl Pl Tr,
+//
+// so the whole sum costs a tree of balanced multiplications instead of one
+// ever-growing fraction. The two halves of the upper levels are evaluated
+// in parallel on the shared thread pool. Progress is counted in terms.
+class HypergeometricSeries {
+public:
+    typedef std::function<BigInteger(size_t)> Term;
+
+    HypergeometricSeries(const Term &a, const Term &b, const Term &p, const Term &q);
+
+    // The sum of the terms below `terms` as one reduced fraction.
+    Rational sum(size_t terms) const;
+    // The sum times 10^digits, truncated toward zero.
+    BigInteger scaled(size_t terms, size_t digits) const;
+    // The same as sum(terms).asDecimal(digits) without forming the fraction.
+    std::string asDecimal(size_t terms, size_t digits) const;
+
+private:
+    struct Split {
+        BigInteger p, q, b, t;
+    };
+
+    Term a_, b_, p_, q_;
+
+    void split(size_t begin, size_t end, Split &result, ProgressReporter &progress) const;
+};
+
+// floor(sqrt(value)) for value >= 0, by Newton's iteration from the root of
+// the upper half of the digits.
+BigInteger squareRoot(const BigInteger &value);
+
+// The constants truncated to `digits` fractional digits: pi by the
+// Chudnovsky series, about 14 digits per term, e by the sum of 1 / n! and
+// log 2 as 2 atanh(1 / 3).
+std::string piDecimal(size_t digits);
+std::string eDecimal(size_t digits);
+std::string log2Decimal(size_t digits);
+
+#endif //SERIES_H
@@ -0,0 +1,37 @@
+//
+// Created by gosktin on 19.10.26.
+//
+
+#ifndef THRESHOLDS_H
+#define THRESHOLDS_H
+
+#include <cstddef>
+
+// A header written by the tune tool can be compiled in with
+// -DNUMERICAL_TUNED_HEADER="path/to/header.h".
+#ifdef NUMERICAL_TUNED_HEADER
+#include NUMERICAL_TUNED_HEADER
+#endif
+
+#ifndef NUMERICAL_KARATSUBA_THRESHOLD
+#define NUMERICAL_KARATSUBA_THRESHOLD 48
+#endif
+
+#ifndef NUMERICAL_KARATSUBA_SQUARE_THRESHOLD
+#define NUMERICAL_KARATSUBA_SQUARE_THRESHOLD 64
+#endif
+
+// Operand sizes, in digits, from which the next algorithm tier takes over.
+// They start at the compiled-in values and can be changed at run time, which
+// is how the tune tool times one tier against the other.
+struct Thresholds {
+    size_t karatsuba;
+    size_t karatsubaSquare;
+};
+
+inline Thresholds &thresholds() {
+    static Thresholds values = {NUMERICAL_KARATSUBA_THRESHOLD, NUMERICAL_KARATSUBA_SQUARE_THRESHOLD};
+    return values;
+}
+
+#endif //THRESHOLDS_H
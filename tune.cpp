@@ -0,0 +1,100 @@
+//
+// Created by gosktin on 19.10.26.
+//
+
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "biginteger.h"
+
+// Finds the crossover points of the algorithm tiers on this machine and
+// writes them as a header to be compiled in with NUMERICAL_TUNED_HEADER.
+//
+// For every size the operation is timed once with the threshold just above
+// the size, so the lower tier does all the work, and once with the
+// threshold equal to the size, so the upper tier is entered at the top and
+// hands the halves back to the lower one. The threshold is the first size
+// from which the upper tier wins several times in a row.
+
+struct Tier {
+    std::string macro;
+    size_t Thresholds::*threshold;
+    std::function<BigInteger(const BigInteger &, const BigInteger &)> operation;
+};
+
+volatile size_t observed;
+
+BigInteger randomNumber(std::mt19937_64 &rng, size_t digits) {
+    std::string s(digits, '0');
+    for (size_t i = 0; i < digits; ++i)
+        s[i] = static_cast<char>('0' + rng() % 10);
+    s[0] = '1';
+
+    return BigInteger(s);
+}
+
+double measure(const Tier &tier, const BigInteger &a, const BigInteger &b, size_t threshold) {
+    typedef std::chrono::steady_clock Clock;
+
+    thresholds().*tier.threshold = threshold;
+    size_t iterations = 0;
+    double elapsed = 0;
+    Clock::time_point start = Clock::now();
+    while (elapsed < 0.02) {
+        observed = tier.operation(a, b).size();
+        ++iterations;
+        elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    return elapsed / iterations;
+}
+
+size_t tune(const Tier &tier, std::mt19937_64 &rng, size_t limit) {
+    const size_t streak = 3;
+
+    Thresholds saved = thresholds();
+    size_t found = limit, wins = 0;
+    for (size_t digits = 4; digits <= limit; digits = max(digits + 1, digits * 9 / 8)) {
+        BigInteger a(randomNumber(rng, digits)), b(randomNumber(rng, digits));
+        double lower = measure(tier, a, b, digits + 1), upper = measure(tier, a, b, digits);
+        std::cerr << tier.macro << ' ' << digits << ": " << lower * 1e6 << " us / " << upper * 1e6 << " us"
+                  << std::endl;
+
+        if (upper < lower) {
+            if (wins++ == 0)
+                found = digits;
+            if (wins == streak)
+                break;
+        } else
+            wins = 0;
+    }
+    thresholds() = saved;
+
+    return found;
+}
+
+int main(int argc, char **argv) {
+    std::string output(argc > 1 ? argv[1] : "tuned_thresholds.h");
+
+    std::vector<Tier> tiers;
+    tiers.push_back({"NUMERICAL_KARATSUBA_THRESHOLD", &Thresholds::karatsuba,
+                     [](const BigInteger &a, const BigInteger &b) { return a * b; }});
+    tiers.push_back({"NUMERICAL_KARATSUBA_SQUARE_THRESHOLD", &Thresholds::karatsubaSquare,
+                     [](const BigInteger &a, const BigInteger &) { return a * a; }});
+
+    std::mt19937_64 rng(20161031);
+    std::ofstream out(output.c_str());
+    out << "// Generated by tune, do not edit.\n\n";
+    for (size_t i = 0; i < tiers.size(); ++i) {
+        size_t threshold = tune(tiers[i], rng, 1024);
+        out << "#define " << tiers[i].macro << ' ' << threshold << '\n';
+        std::cout << tiers[i].macro << ' ' << threshold << std::endl;
+    }
+
+    return out ? 0 : 1;
+}